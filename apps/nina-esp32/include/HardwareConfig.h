@@ -1,6 +1,8 @@
 #pragma once
 #include <Arduino.h>
-#include <AnalogSensors.h> // For TempVPoint definition
+#include <AnalogConfig.h>  // For TempVPoint definition
+#include <RPM.h>           // For RpmBarCurve
+#include <RPMInput.h>      // For RPMInput::Mode
 
 // ─────────────────────────────────────────────
 // NINABrain – Hardware Configuration
@@ -27,6 +29,13 @@ constexpr uint8_t PIN_LIGHTS = 12; // ⚠ boot strap pin
 constexpr uint8_t PIN_FOG = 13;
 constexpr uint8_t PIN_BATTERY = 33; // Alternator D+
 
+// Debounce: a level must hold for 4 samples (15–20 ms at 5 ms)
+constexpr uint8_t DIGITAL_DEBOUNCE_SAMPLE_MS = 5;
+
+// Edge interrupts drive the warning, indicator and high-beam lights directly
+// (sub-ms, loop-independent, bounce locked out in the ISR)
+constexpr bool DIGITAL_INPUT_EVENTS = true;
+
 // Optional / future
 constexpr uint8_t PIN_HALL = 39;
 
@@ -46,6 +55,13 @@ constexpr uint8_t FUEL_SCL = 19;
 constexpr uint8_t OLED_ADDR = 0x3C;
 constexpr uint8_t LCD_ADDR = 0x27; // Common default address for I2C LCD backpacks (may need adjustment)
 
+// Bus scheduling (I2CBus): framebuffers go out in chunks so short polls
+// can cut in between. A bus runs at its slowest device's limit.
+constexpr uint32_t OLED_I2C_MAX_HZ = 400000; // SSD1306 spec; most modules take 1000000 (Fm+)
+constexpr uint16_t I2C_CHUNK_BYTES = 32;	 // ≈ 0.8 ms at 400 kHz, 0.3 ms at 1 MHz
+constexpr BaseType_t I2C_TASK_CORE = 0;
+constexpr UBaseType_t I2C_TASK_PRIORITY = 2; // above the display task
+
 // =================================================
 // ===== SHIFT REGISTER OUTPUTS (shared SRCLK)
 // =================================================
@@ -65,19 +81,62 @@ constexpr uint8_t SPD_DATA = 16;
 constexpr uint8_t SPD_LATCH = 4;
 
 // =================================================
-// ===== MULTIPLEX TIMING (milliseconds)
+// ===== MULTIPLEX TIMING (microseconds)
+// =================================================
+// One hardware timer (MuxScheduler) ticks every MUX_TICK_US and
+// refreshes each chain on its own phase-staggered slot.
+// Per-chain periods must be multiples of MUX_TICK_US.
+// Only ParallelGpio is ISR-safe; BitBang and SpiDma chains fall back
+// to Ticker, which runs on whole ms: periods round down to a multiple
+// of 1000, and periods below 1000 don't build – BCM on 1 ms ticks would
+// stretch the speedo cycle from 5.25 ms to 21 ms (~48 Hz flicker).
+
+constexpr uint8_t MUX_TIMER_NUM = 0;	// general-purpose timer 0 (group 0, index 0)
+constexpr uint32_t MUX_TICK_US = 250; // scheduler base tick
+
+// With BCM dimming one channel takes 7 periods (3 bit-planes: 1+2+4),
+// so the speedo cycles every 3 × 7 × SPD_MUX_US.
+constexpr uint32_t RPM_MUX_US = 250;  // bar
+constexpr uint32_t SPD_MUX_US = 250;  // digits (~190 Hz per digit)
+constexpr uint32_t DASH_MUX_US = 250; // warning lights
+
+// =================================================
+// ===== NIGHT DIMMING (follows headlight input)
 // =================================================
-// attach_ms() is used (ESP32 core Ticker)
 
-constexpr uint32_t RPM_MUX_MS = 1;	// fast bar refresh
-constexpr uint32_t SPD_MUX_MS = 1;	// digits
-constexpr uint32_t DASH_MUX_MS = 2; // warning lights
+constexpr uint8_t LED_LEVEL_DAY = 7;   // 0–7, BCM level for LEDs
+constexpr uint8_t LED_LEVEL_NIGHT = 2;
+
+constexpr uint8_t OLED_CONTRAST_DAY = 0xCF; // SSD1306 default (SWITCHCAPVCC)
+constexpr uint8_t OLED_CONTRAST_NIGHT = 0x08;
+
+// =================================================
+// ===== MULTIPLEX TRANSPORT
+// =================================================
+// All chains share SRCLK – pick ONE backend for all of them.
+// BitBang      : shiftOut() + digitalWrite (fallback)
+// SpiDma       : one DMA transaction per chain, latch on transfer complete
+//                (task context only – these chains stay on Ticker)
+// ParallelGpio : all chains clocked together on SRCLK, one bit per chain
+//                per edge via GPIO.out_w1ts/w1tc (pins must be < 32)
+
+enum class MuxBackend : uint8_t
+{
+	BitBang,
+	SpiDma,
+	ParallelGpio
+};
+
+constexpr MuxBackend MUX_BACKEND = MuxBackend::ParallelGpio;
+
+constexpr uint32_t MUX_SPI_HZ = 4000000; // long SRCLK trace to display PCB
 
 // =================================================
 // ===== FUEL CALIBRATION
 // =================================================
 
 constexpr uint8_t LOW_FUEL_THRESHOLD = 20; // %
+constexpr uint8_t FUEL_RESTORE_TOLERANCE_PCT = 5; // boot burst vs. last saved level
 constexpr float FUEL_ADC_V_MIN = 0.40f;	   // empty
 constexpr float FUEL_ADC_V_MAX = 1.80f;	   // full
 
@@ -88,9 +147,54 @@ constexpr float FUEL_ADC_V_MAX = 1.80f;	   // full
 // pulses per engine revolution (adjust to ignition type)
 constexpr uint8_t RPM_PULSES_PER_REV = 2;
 
-// measurement window (ms)
+// measurement window (ms), Window mode
 constexpr uint16_t RPM_SAMPLE_MS = 200;
 
+// Period mode times every pulse: ~1 rev latency, sub-rpm resolution
+constexpr RPMInput::Mode RPM_MODE = RPMInput::Mode::Period;
+constexpr uint8_t RPM_AVG_PULSES = RPM_PULSES_PER_REV; // one revolution
+constexpr uint16_t RPM_STOP_TIMEOUT_MS = 500;          // no pulse → 0 rpm
+constexpr uint16_t RPM_MAX_VALID = 12000;              // faster = ignition noise
+
+// oil lamp flashes (pressure warning) only above this – engine running
+constexpr uint16_t OIL_WARN_MIN_RPM = 400;
+
+// =================================================
+// ===== PULSE INPUT BACKEND
+// =================================================
+// Isr  : one interrupt per edge (needed for RPM Period mode timestamps)
+// Pcnt : hardware pulse counter + glitch filter, one interrupt per
+//        30000 pulses; RPM falls back to Window counting. Counts are
+//        stamped at poll time, so after a stalled loop() low-speed
+//        readings are off by several km/h – speed stays on Isr too.
+
+enum class PulseBackend : uint8_t
+{
+	Isr,
+	Pcnt
+};
+
+constexpr PulseBackend RPM_PULSE_BACKEND = PulseBackend::Isr;
+constexpr PulseBackend SPEED_PULSE_BACKEND = PulseBackend::Isr;
+
+constexpr pcnt_unit_t RPM_PCNT_UNIT = PCNT_UNIT_0;
+constexpr pcnt_unit_t SPEED_PCNT_UNIT = PCNT_UNIT_1; // first wheel channel, then +1 each
+
+constexpr uint16_t RPM_GLITCH_NS = 10000;  // ignition ringing (max ~12700)
+constexpr uint16_t SPEED_GLITCH_NS = 2000; // hall sensor bounce
+
+// =================================================
+// ===== RPM BAR
+// =================================================
+// Curves: Linear, Progressive (quadratic), Redline (last
+// RPM_BAR_RED_LEDS cover redline → max). Table is built at compile time.
+
+constexpr uint16_t RPM_BAR_MAX_RPM = 8000;
+constexpr uint16_t RPM_BAR_REDLINE_RPM = 6000;
+constexpr uint8_t RPM_BAR_RED_LEDS = 5;
+constexpr uint16_t RPM_BAR_STEP_RPM = 50; // quantization, must divide RPM_BAR_MAX_RPM
+constexpr RpmBarCurve RPM_BAR_CURVE = RpmBarCurve::Linear;
+
 // =================================================
 // ===== ADC SETTINGS
 // =================================================
@@ -99,6 +203,10 @@ constexpr uint8_t ADC_BITS = 12;
 constexpr float ADC_REF_V = 3.3f;
 constexpr uint16_t ADC_MAX = (1 << ADC_BITS) - 1;
 
+// Continuous DMA sampling, shared by all ADC1 channels
+constexpr uint32_t ADC_SAMPLE_HZ = 20000;	 // total; ESP32 minimum
+constexpr uint8_t ADC_OVERSAMPLE_BITS = 4; // 256 samples/value, ~39 Hz per channel (2 ch)
+
 // =================================================
 // ===== ADC INPUT DIVIDER (shared by analog inputs)
 // Vin -> R1 -> ADC -> R2 -> GND
@@ -116,7 +224,7 @@ constexpr float ADC_DIV_INV =
 // =================================================
 // ===== YUGO TEMP SENSOR (ADC-voltage LUT)
 // =================================================
-// Note: TempVPoint is defined in AnalogSensors.h
+// Note: TempVPoint is defined in AnalogConfig.h
 
 // ORDER: cold → hot (voltage usually rises with temp)
 constexpr TempVPoint TEMP_V_TABLE[] = {
@@ -143,4 +251,57 @@ constexpr float METERS_PER_MILE = 1609.344f;
 constexpr uint32_t HALL_PULSES_PER_MILE = 3200;
 
 constexpr float SPEEDO_METERS_PER_PULSE =
-	METERS_PER_MILE / HALL_PULSES_PER_MILE; // ≈ 0.503 m
\ No newline at end of file
+	METERS_PER_MILE / HALL_PULSES_PER_MILE; // ≈ 0.503 m
+
+// Odometer works in integer micrometres: 1609.344 m / 3200 = 502920 µm
+constexpr uint64_t UM_PER_MILE = 1609344000ULL;
+constexpr uint32_t HALL_UM_PER_PULSE = UM_PER_MILE / HALL_PULSES_PER_MILE;
+static_assert(UM_PER_MILE % HALL_PULSES_PER_MILE == 0, "µm per pulse must be exact");
+
+// ======================
+// WHEEL SPEED CHANNELS
+// ======================
+// One hall sensor per entry (wheels, driveshaft); the speedo shows the
+// average. Add pins here – everything else is sized from this array.
+
+constexpr uint8_t WHEEL_SPEED_PINS[] = {PIN_HALL};
+constexpr uint8_t WHEEL_SPEED_CHANNELS = sizeof(WHEEL_SPEED_PINS);
+
+constexpr float WHEEL_SLIP_RATIO = 0.15f; // 15 % off the average
+constexpr float WHEEL_SLIP_MIN_KPH = 5.0f; // ignore at walking pace
+
+constexpr uint8_t ODOMETER_CHANNEL = 0; // wheel channel that drives the odometer
+
+// ======================
+// ODOMETER PERSISTENCE
+// ======================
+// Log partition from partitions.csv: 16 sectors × 128 records. At the
+// fastest rate (one record per ODO_COMMIT_MIN_MS) a sector is erased
+// every ~17 h of driving – 100k cycles outlast the car.
+// Standing still writes nothing; a final record (with run time and
+// fuel) is written when the D+ input drops.
+
+constexpr const char *ODO_LOG_LABEL = "odolog";
+constexpr uint32_t ODO_COMMIT_METERS = 1000;		 // every km ...
+constexpr uint32_t ODO_COMMIT_MAX_MS = 10UL * 60 * 1000; // ... or 10 min after moving
+constexpr uint32_t ODO_COMMIT_MIN_MS = 30UL * 1000;	 // never faster than this
+
+// ======================
+// TRIP COMPUTER
+// ======================
+
+constexpr uint16_t TRIP_RPM_BAND_WIDTH = 1000; // 8 bands, last one open-ended
+constexpr float TRIP_MOVING_KPH = 2.0f;		   // slower = stopped / idling
+constexpr uint32_t MAIN_SCREEN_ROTATE_MS = 8000; // odometer ↔ trip page
+
+// ======================
+// DISPLAY TASK
+// ======================
+// OLED rendering and I2C flushes run on their own task; loop() (core 1)
+// only posts a snapshot. Core 0 is shared with WiFi, which outranks it.
+
+constexpr BaseType_t DISPLAY_TASK_CORE = 0;
+constexpr UBaseType_t DISPLAY_TASK_PRIORITY = 1;
+constexpr uint32_t DISPLAY_FRAME_MS = 200; // 5 Hz, newest snapshot wins
+
+static_assert(SPEED_PCNT_UNIT + WHEEL_SPEED_CHANNELS <= PCNT_UNIT_MAX, "not enough PCNT units");
\ No newline at end of file
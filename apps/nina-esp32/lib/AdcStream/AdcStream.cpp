@@ -0,0 +1,196 @@
+#include "AdcStream.h"
+
+// SD from n, Σx and Σx² (exact in 64 bits), in 1/100 of `unit`
+static uint16_t noiseCenti(uint32_t n, uint64_t sum, uint64_t sumSq, uint32_t unit)
+{
+    if (n < 2)
+        return 0;
+
+    uint64_t varN2 = n * sumSq - sum * sum; // variance × n²
+    float sd = sqrtf(static_cast<float>(varN2)) / n;
+    float centi = sd * 100.0f / unit + 0.5f;
+    return centi > 65535.0f ? 65535 : static_cast<uint16_t>(centi);
+}
+
+AdcStream::AdcStream(uint32_t sampleHz, uint8_t oversampleBits)
+    : sampleHz(sampleHz),
+      osBits(oversampleBits > 4 ? 4 : oversampleBits), // 12 + 4 bits fits uint16_t
+      blockSamples(1 << (2 * osBits))
+{
+    memset(slotOf, NO_SLOT, sizeof(slotOf));
+}
+
+int8_t AdcStream::addPin(uint8_t pin)
+{
+    if (started || channelCount >= MAX_CHANNELS)
+        return -1;
+
+    // Arduino numbering: 0..7 = ADC1, 10.. = ADC2
+    int8_t ch = digitalPinToAnalogChannel(pin);
+    if (ch < 0 || ch >= ADC1_CHANNELS)
+        return -1;
+
+    if (slotOf[ch] != NO_SLOT)
+        return slotOf[ch]; // already scanned
+
+    Channel &c = channels[channelCount];
+    c.pin = pin;
+    c.adcChannel = ch;
+    c.lo = 0xFFFF;
+
+    slotOf[ch] = channelCount;
+    return channelCount++;
+}
+
+bool AdcStream::begin()
+{
+    if (started || channelCount == 0)
+        return false;
+
+    adc_digi_init_config_t init = {};
+    init.max_store_buf_size = STORE_BYTES;
+    init.conv_num_each_intr = READ_CHUNK;
+    for (uint8_t i = 0; i < channelCount; i++)
+    {
+        init.adc1_chan_mask |= 1UL << channels[i].adcChannel;
+    }
+
+    if (adc_digi_initialize(&init) != ESP_OK)
+        return false;
+
+    adc_digi_pattern_config_t pattern[MAX_CHANNELS] = {};
+    for (uint8_t i = 0; i < channelCount; i++)
+    {
+        pattern[i].atten = ADC_ATTEN_DB_11; // full 0–3.3 V range
+        pattern[i].channel = channels[i].adcChannel;
+        pattern[i].unit = 0; // ADC1
+        pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    }
+
+    adc_digi_configuration_t cfg = {};
+    cfg.conv_limit_en = true; // required on the classic ESP32
+    cfg.conv_limit_num = 250;
+    cfg.pattern_num = channelCount;
+    cfg.adc_pattern = pattern;
+    cfg.sample_freq_hz = sampleHz;
+    cfg.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    cfg.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+
+    if (adc_digi_controller_configure(&cfg) != ESP_OK ||
+        adc_digi_start() != ESP_OK)
+    {
+        adc_digi_deinitialize();
+        return false;
+    }
+
+    started = true;
+    return true;
+}
+
+void AdcStream::update()
+{
+    if (!started)
+        return;
+
+    // Bounded: at most what sits in the driver's store buffer
+    for (uint32_t n = 0; n < STORE_BYTES / READ_CHUNK; n++)
+    {
+        uint32_t len = 0;
+        esp_err_t err = adc_digi_read_bytes(buffer, READ_CHUNK, &len, 0);
+
+        if (err == ESP_ERR_INVALID_STATE)
+            overrunCount++; // store buffer was full, data still valid
+        else if (err != ESP_OK)
+            break; // ESP_ERR_TIMEOUT: drained
+
+        for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= len; i += SOC_ADC_DIGI_RESULT_BYTES)
+        {
+            const adc_digi_output_data_t *d =
+                reinterpret_cast<const adc_digi_output_data_t *>(&buffer[i]);
+
+            uint8_t ch = d->type1.channel;
+            if (ch >= ADC1_CHANNELS || slotOf[ch] == NO_SLOT)
+                continue;
+
+            addSample(channels[slotOf[ch]], d->type1.data);
+        }
+
+        if (len < READ_CHUNK)
+            break;
+    }
+}
+
+void AdcStream::addSample(Channel &c, uint16_t raw)
+{
+    c.sum += raw;
+    c.sumSq += static_cast<uint32_t>(raw) * raw;
+    if (raw < c.lo)
+        c.lo = raw;
+    if (raw > c.hi)
+        c.hi = raw;
+
+    if (++c.count < blockSamples)
+        return;
+
+    // sum of 4^OS samples >> OS = 12 + OS bit result
+    c.value = c.sum >> osBits;
+    c.spread = c.hi - c.lo;
+    c.rawNoise = noiseCenti(blockSamples, c.sum, c.sumSq, 1);
+    c.seq++;
+    updateValueNoise(c);
+
+    c.sum = 0;
+    c.sumSq = 0;
+    c.count = 0;
+    c.lo = 0xFFFF;
+    c.hi = 0;
+}
+
+// Once per block: spread of the decimated values themselves, in 12-bit
+// LSB like the raw figure
+void AdcStream::updateValueNoise(Channel &c)
+{
+    c.history[c.seq % NOISE_BLOCKS] = c.value;
+    if (c.historyCount < NOISE_BLOCKS)
+        c.historyCount++;
+
+    uint64_t sum = 0;
+    uint64_t sumSq = 0;
+    for (uint8_t i = 0; i < c.historyCount; i++)
+    {
+        sum += c.history[i];
+        sumSq += static_cast<uint64_t>(c.history[i]) * c.history[i];
+    }
+
+    c.valueNoise = noiseCenti(c.historyCount, sum, sumSq, 1 << osBits);
+}
+
+uint16_t AdcStream::value(uint8_t slot) const
+{
+    return slot < channelCount ? channels[slot].value : 0;
+}
+
+uint16_t AdcStream::maxValue() const
+{
+    return 4095U << osBits; // (4095 × 4^OS) >> OS
+}
+
+uint16_t AdcStream::sequence(uint8_t slot) const
+{
+    return slot < channelCount ? channels[slot].seq : 0;
+}
+
+uint16_t AdcStream::rawSpread(uint8_t slot) const
+{
+    return slot < channelCount ? channels[slot].spread : 0;
+}
+
+uint16_t AdcStream::rawNoise(uint8_t slot) const
+{
+    return slot < channelCount ? channels[slot].rawNoise : 0;
+}
+
+uint16_t AdcStream::valueNoise(uint8_t slot) const
+{
+    return slot < channelCount ? channels[slot].valueNoise : 0;
+}
@@ -0,0 +1,102 @@
+#ifndef NINA_ADCSTREAM_H
+#define NINA_ADCSTREAM_H
+
+#pragma once
+
+#include <Arduino.h>
+#include <driver/adc.h>
+
+// Continuous ADC1 acquisition (IDF digital controller + DMA).
+// The hardware scans every added pin at a fixed rate; update() drains the
+// DMA buffer without blocking and decimates each channel by 4^OS samples,
+// keeping OS extra bits (12 + OS bit result). Averaging 4^OS samples cuts
+// white noise (WiFi, ignition) by 2^OS.
+//
+// One instance per chip – the digital controller is a single peripheral.
+// analogRead() must not be used on ADC1 while the stream runs.
+class AdcStream
+{
+public:
+    static constexpr uint8_t MAX_CHANNELS = 8;
+
+    // sampleHz is the total conversion rate, shared by all channels
+    // (ESP32: 20 kHz minimum)
+    AdcStream(uint32_t sampleHz, uint8_t oversampleBits);
+
+    // ADC1 pins only (ADC2 is blocked by WiFi). Returns a slot or -1.
+    // Call before begin().
+    int8_t addPin(uint8_t pin);
+
+    bool begin();
+
+    // Drain and decimate whatever the DMA produced since the last call
+    void update();
+
+    // Latest decimated value, 0 .. maxValue()
+    uint16_t value(uint8_t slot) const;
+    uint16_t maxValue() const;
+    uint8_t oversampleBits() const { return osBits; }
+
+    // Incremented per decimated value – lets consumers filter at a fixed
+    // rate instead of once per loop()
+    uint16_t sequence(uint8_t slot) const;
+
+    // Peak-to-peak of the raw 12-bit samples in the last block (noise)
+    uint16_t rawSpread(uint8_t slot) const;
+
+    // Noise before and after decimation, as standard deviation in 1/100
+    // of a 12-bit LSB: raw samples within the last block, and decimated
+    // values over the last NOISE_BLOCKS blocks. White noise drops by 2^OS.
+    static constexpr uint8_t NOISE_BLOCKS = 16;
+    uint16_t rawNoise(uint8_t slot) const;
+    uint16_t valueNoise(uint8_t slot) const;
+
+    // Samples lost because update() was not called in time
+    uint32_t overruns() const { return overrunCount; }
+
+    bool running() const { return started; }
+
+private:
+    static constexpr uint32_t READ_CHUNK = 256;     // bytes per DMA read
+    static constexpr uint32_t STORE_BYTES = 4096;   // ~100 ms at 20 kHz
+    static constexpr uint8_t NO_SLOT = 0xFF;
+    static constexpr uint8_t ADC1_CHANNELS = 8;
+
+    struct Channel
+    {
+        uint8_t pin;
+        uint8_t adcChannel;
+
+        uint32_t sum;
+        uint32_t sumSq; // 4^4 × 4095² still fits
+        uint16_t count;
+        uint16_t lo;
+        uint16_t hi;
+
+        uint16_t value;
+        uint16_t spread;
+        uint16_t seq;
+
+        uint16_t history[NOISE_BLOCKS]; // last decimated values
+        uint8_t historyCount;
+        uint16_t rawNoise;
+        uint16_t valueNoise;
+    };
+
+    void addSample(Channel &c, uint16_t raw);
+    void updateValueNoise(Channel &c);
+
+    uint32_t sampleHz;
+    uint8_t osBits;
+    uint16_t blockSamples;
+
+    Channel channels[MAX_CHANNELS]{};
+    uint8_t channelCount = 0;
+    uint8_t slotOf[ADC1_CHANNELS];
+
+    uint8_t buffer[READ_CHUNK];
+    uint32_t overrunCount = 0;
+    bool started = false;
+};
+
+#endif // NINA_ADCSTREAM_H
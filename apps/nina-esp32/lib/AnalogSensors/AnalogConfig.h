@@ -0,0 +1,36 @@
+#ifndef NINA_ANALOGCONFIG_H
+#define NINA_ANALOGCONFIG_H
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Calibration only – no driver dependencies, so the conversion tables
+// (AnalogLut.h) build on the host too.
+
+struct TempVPoint
+{
+    float vadc; // volts at ESP32 ADC pin (AFTER divider)
+    int tempC;  // °C
+};
+
+struct AnalogSensorsConfig
+{
+    // ADC settings
+    uint8_t adcBits;
+    float adcRefV;
+    uint16_t adcMax;
+
+    // Temperature calibration
+    const TempVPoint* tempVTable;
+    size_t tempVTableSize;
+    int tempMinC;
+    int tempMaxC;
+
+    // Fuel calibration
+    float fuelAdcVMin; // empty
+    float fuelAdcVMax; // full
+};
+
+#endif // NINA_ANALOGCONFIG_H
@@ -0,0 +1,97 @@
+#ifndef NINA_ANALOGLUT_H
+#define NINA_ANALOGLUT_H
+
+#pragma once
+
+#include <Arduino.h>
+#include "AnalogConfig.h"
+
+// Sensor conversions, shared by the compile-time table and the float
+// fallback so both give identical results for the same ADC count.
+
+// Linear interpolation in ADC-voltage domain, clamped to the table ends
+constexpr int analogTempFromVolts(const AnalogSensorsConfig &c, float v)
+{
+    for (size_t i = 0; i < c.tempVTableSize - 1; i++)
+    {
+        const TempVPoint &p1 = c.tempVTable[i];
+        const TempVPoint &p2 = c.tempVTable[i + 1];
+
+        if (v >= p1.vadc && v <= p2.vadc)
+        {
+            float t =
+                p1.tempC +
+                (p2.tempC - p1.tempC) *
+                    (v - p1.vadc) /
+                    (p2.vadc - p1.vadc);
+
+            return static_cast<int>(t);
+        }
+    }
+
+    if (v < c.tempVTable[0].vadc)
+        return c.tempVTable[0].tempC;
+
+    return c.tempVTable[c.tempVTableSize - 1].tempC;
+}
+
+constexpr int16_t analogTempC(const AnalogSensorsConfig &c, float counts)
+{
+    float vadc = (counts / c.adcMax) * c.adcRefV;
+    return constrain(analogTempFromVolts(c, vadc), c.tempMinC, c.tempMaxC);
+}
+
+// Map temperature to 0–100% (for bar display)
+constexpr uint8_t analogTempPercent(const AnalogSensorsConfig &c, int t)
+{
+    float pct =
+        (float)(t - c.tempMinC) /
+        (c.tempMaxC - c.tempMinC) * 100.0f;
+
+    return constrain(static_cast<int>(pct), 0, 100);
+}
+
+// Fuel sensor is INVERTED: full = low voltage, empty = high voltage
+constexpr uint8_t analogFuelPercent(const AnalogSensorsConfig &c, float counts)
+{
+    // 0 counts = open sender / no reading yet
+    if (counts <= 0 || counts > c.adcMax)
+        return 0;
+
+    float vadc = (counts / (float)c.adcMax) * c.adcRefV;
+
+    float pct =
+        (c.fuelAdcVMax - vadc) /
+        (c.fuelAdcVMax - c.fuelAdcVMin) * 100.0f;
+
+    return constrain(static_cast<int>(pct), 0, 100);
+}
+
+// One entry per 12-bit ADC count; ~16 KB, lives in flash when constexpr.
+// Build with: constexpr AnalogLut lut = makeAnalogLut(config);
+struct AnalogLut
+{
+    static constexpr uint16_t SIZE = 4096;
+
+    int16_t tempC[SIZE];
+    uint8_t tempPct[SIZE];
+    uint8_t fuelPct[SIZE];
+};
+
+constexpr AnalogLut makeAnalogLut(const AnalogSensorsConfig &c)
+{
+    AnalogLut lut{};
+
+    for (uint16_t n = 0; n < AnalogLut::SIZE; n++)
+    {
+        float counts = n > c.adcMax ? c.adcMax : n;
+
+        lut.tempC[n] = analogTempC(c, counts);
+        lut.tempPct[n] = analogTempPercent(c, lut.tempC[n]);
+        lut.fuelPct[n] = analogFuelPercent(c, counts);
+    }
+
+    return lut;
+}
+
+#endif // NINA_ANALOGLUT_H
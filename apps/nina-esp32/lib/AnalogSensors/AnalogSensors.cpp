@@ -1,17 +1,25 @@
 #include "AnalogSensors.h"
-#include <math.h>
+#include "AnalogLut.h"
 
 // -------------------------------------------------
 // Constructor
 // -------------------------------------------------
 
-AnalogSensors::AnalogSensors(const Pins &p, const AnalogSensorsConfig &c)
-    : pins(p), config(c) {}
+AnalogSensors::AnalogSensors(const Pins &p, const AnalogSensorsConfig &c, const AnalogLut *l)
+    : pins(p), config(c), lut(l)
+{
+  convert();
+}
 
 // -------------------------------------------------
 // Init
 // -------------------------------------------------
 
+void AnalogSensors::setStream(AdcStream &s)
+{
+  stream = &s;
+}
+
 void AnalogSensors::begin()
 {
   analogReadResolution(config.adcBits);
@@ -19,102 +27,174 @@ void AnalogSensors::begin()
   // Make ADC range truthful (0–3.3V)
   analogSetPinAttenuation(pins.temp, ADC_11db);
   analogSetPinAttenuation(pins.fuel, ADC_11db);
-}
 
-// -------------------------------------------------
-// Update (call every loop)
-// -------------------------------------------------
+  // Pre-warm: the median of a fast burst seeds every filter stage, so
+  // the gauges don't crawl up from empty/cold (and LOW_FUEL doesn't
+  // flash). Runs before the DMA stream owns ADC1; ~2 ms.
+  seed(tempChain, tempFiltered, tempLast, tempUs, burstMedian(pins.temp));
+  seed(fuelChain, fuelFiltered, fuelLast, fuelUs, burstMedian(pins.fuel));
+  convert();
 
-void AnalogSensors::update()
+  if (stream)
+  {
+    // Attenuation is set again per pattern entry
+    tempSlot = stream->addPin(pins.temp);
+    fuelSlot = stream->addPin(pins.fuel);
+  }
+}
+
+// counts × 2^Q, 0 if every read was a glitch
+int32_t AnalogSensors::burstMedian(uint8_t pin) const
 {
-  uint16_t rawTemp = analogRead(pins.temp);
-  uint16_t rawFuel = analogRead(pins.fuel);
+  uint16_t sorted[WARMUP_SAMPLES];
+  uint8_t n = 0;
 
-  // Validate ADC readings (clamp to reasonable range, ignore 0s from connection glitches)
-  // For 12-bit ADC, max is 4095 - validate it's not corrupted
-  if (rawTemp > config.adcMax) rawTemp = config.adcMax;
-  if (rawFuel > config.adcMax) rawFuel = config.adcMax;
-  
-  // Skip filtering if reading is 0 (connection glitch) - keep last valid value
-  // This prevents spikes when wires briefly disconnect
-  if (rawTemp > 0) {
-    tempFiltered = tempFiltered * 0.9f + rawTemp * 0.1f;
-  }
-  
-  if (rawFuel > 0) {
-    fuelFiltered = fuelFiltered * 0.9f + rawFuel * 0.1f;
+  for (uint8_t i = 0; i < WARMUP_SAMPLES; i++)
+  {
+    uint16_t v = analogRead(pin);
+    if (v == 0 || v > config.adcMax)
+      continue; // same rejection as filter()
+
+    int8_t j = n - 1;
+    while (j >= 0 && sorted[j] > v)
+    {
+      sorted[j + 1] = sorted[j];
+      j--;
+    }
+    sorted[j + 1] = v;
+    n++;
   }
+
+  return n ? static_cast<int32_t>(sorted[n / 2]) << Q : 0;
 }
 
-// =================================================
-// ============ TEMPERATURE (OEM YUGO, ADC LUT)
-// =================================================
+template <typename Chain>
+void AnalogSensors::seed(Chain &chain, int32_t &filtered, int32_t &last, uint32_t &lastUs, int32_t raw)
+{
+  if (raw <= 0)
+    return; // no valid reads – the first sample primes the chain instead
+
+  chain.reset(raw);
+  filtered = raw;
+  last = raw;
+  lastUs = micros();
+  warmedUp = true;
+}
 
-// Linear interpolation in ADC-voltage domain
-int AnalogSensors::interpolateTempFromVoltage(float v) const
+bool AnalogSensors::restoreFuelPercent(uint8_t pct, uint8_t tolerancePct)
 {
-  for (size_t i = 0; i < config.tempVTableSize - 1; i++)
-  {
-    const auto &p1 = config.tempVTable[i];
-    const auto &p2 = config.tempVTable[i + 1];
+  if (!warmedUp || pct > 100)
+    return false;
+
+  int diff = static_cast<int>(fuelPctCached) - pct;
+  if (diff > tolerancePct || diff < -static_cast<int>(tolerancePct))
+    return false;
+
+  // Inverse of analogFuelPercent(), aimed at the middle of the percent
+  // step so the LUT's truncation lands on pct (sender is inverted)
+  float vadc = config.fuelAdcVMax -
+               (pct + 0.5f) / 100.0f * (config.fuelAdcVMax - config.fuelAdcVMin);
+  int32_t raw = static_cast<int32_t>(vadc / config.adcRefV * config.adcMax * (1 << Q) + 0.5f);
+
+  int32_t maxQ = static_cast<int32_t>(config.adcMax) << Q;
+  if (raw < 1 || raw > maxQ)
+    return false;
+
+  fuelChain.reset(raw);
+  fuelFiltered = raw;
+  convert();
+  return true;
+}
 
-    if (v >= p1.vadc && v <= p2.vadc)
-    {
-      float t =
-          p1.tempC +
-          (p2.tempC - p1.tempC) *
-              (v - p1.vadc) /
-              (p2.vadc - p1.vadc);
+// -------------------------------------------------
+// Update (call every loop)
+// -------------------------------------------------
 
-      return static_cast<int>(t);
-    }
+// Streamed: one sample per decimated block, so the filter runs at the
+// hardware rate no matter how fast loop() spins. Fallback: analogRead()
+// (no stream, pin not on ADC1, or the stream failed to start).
+// raw comes back in counts × 2^Q
+bool AnalogSensors::nextSample(int8_t slot, uint16_t &seq, uint8_t pin, int32_t &raw)
+{
+  if (slot < 0 || !stream->running())
+  {
+    raw = static_cast<int32_t>(analogRead(pin)) << Q;
+    return true;
   }
 
-  // Out-of-range safety
-  if (v < config.tempVTable[0].vadc)
-    return config.tempVTable[0].tempC;
+  uint16_t s = stream->sequence(slot);
+  if (s == seq)
+    return false;
 
-  return config.tempVTable[config.tempVTableSize - 1].tempC;
+  seq = s;
+
+  // Stream values carry 12 + OS bits; keep Q of the extra ones
+  int8_t shift = 12 + stream->oversampleBits() - config.adcBits - Q;
+  int32_t v = stream->value(slot);
+  raw = shift >= 0 ? v >> shift : v << -shift;
+  return true;
 }
 
-int16_t AnalogSensors::tempC() const
+template <typename Chain>
+void AnalogSensors::filter(Chain &chain, int32_t &filtered, int32_t &last, uint32_t &lastUs, int32_t raw)
 {
-  float vadc = (tempFiltered / config.adcMax) * config.adcRefV;
+  uint32_t nowUs = micros();
+  uint32_t dtUs = nowUs - lastUs;
+  lastUs = nowUs;
+
+  // Validate ADC readings (clamp to reasonable range, ignore 0s from connection glitches)
+  // For 12-bit ADC, max is 4095 - validate it's not corrupted
+  int32_t maxQ = static_cast<int32_t>(config.adcMax) << Q;
+  if (raw > maxQ) raw = maxQ;
+  last = raw;
 
-  int t = interpolateTempFromVoltage(vadc);
-  return constrain(t, config.tempMinC, config.tempMaxC);
+  // Skip filtering if reading is 0 (connection glitch) - keep last valid value
+  // This prevents spikes when wires briefly disconnect
+  if (raw > 0) {
+    filtered = chain.step(raw, dtUs);
+  }
 }
 
-// Map temperature to 0–100% (for bar display)
-uint8_t AnalogSensors::tempPercent() const
+void AnalogSensors::update()
 {
-  int t = tempC();
+  int32_t raw;
+  bool fresh = false;
 
-  float pct =
-      (float)(t - config.tempMinC) /
-      (config.tempMaxC - config.tempMinC) * 100.0f;
+  if (nextSample(tempSlot, tempSeq, pins.temp, raw))
+  {
+    filter(tempChain, tempFiltered, tempLast, tempUs, raw);
+    fresh = true;
+  }
 
-  return constrain(static_cast<int>(pct), 0, 100);
+  if (nextSample(fuelSlot, fuelSeq, pins.fuel, raw))
+  {
+    filter(fuelChain, fuelFiltered, fuelLast, fuelUs, raw);
+    fresh = true;
+  }
+
+  if (fresh)
+    convert();
 }
 
 // =================================================
-// ================= FUEL SENDER
+// ============ CONVERSIONS (see AnalogLut.h)
 // =================================================
 
-uint8_t AnalogSensors::fuelPercent() const
+void AnalogSensors::convert()
 {
-  // Safety check - if filtered value is invalid, return 0
-  if (fuelFiltered <= 0 || fuelFiltered > config.adcMax) {
-    return 0;
+  if (lut)
+  {
+    // Nearest 12-bit count; filter() keeps both within 0..adcMax
+    uint16_t t = (tempFiltered + (1 << (Q - 1))) >> Q;
+    uint16_t f = (fuelFiltered + (1 << (Q - 1))) >> Q;
+
+    tempCached = lut->tempC[t];
+    tempPctCached = lut->tempPct[t];
+    fuelPctCached = lut->fuelPct[f];
+    return;
   }
-  
-  float vadc = (fuelFiltered / (float)config.adcMax) * config.adcRefV;
-
-  // Fuel sensor is INVERTED: full = low voltage, empty = high voltage
-  // So we invert the percentage calculation
-  float pct =
-      (config.fuelAdcVMax - vadc) /
-      (config.fuelAdcVMax - config.fuelAdcVMin) * 100.0f;
 
-  return constrain(static_cast<int>(pct), 0, 100);
-}
\ No newline at end of file
+  tempCached = analogTempC(config, tempFiltered / (float)(1 << Q));
+  tempPctCached = analogTempPercent(config, tempCached);
+  fuelPctCached = analogFuelPercent(config, fuelFiltered / (float)(1 << Q));
+}
@@ -7,30 +7,11 @@
 
 #pragma once
 #include <Arduino.h>
+#include <AdcStream.h>
+#include <Filters.h>
+#include "AnalogConfig.h"
 
-struct TempVPoint
-{
-    float vadc; // volts at ESP32 ADC pin (AFTER divider)
-    int tempC;  // °C
-};
-
-struct AnalogSensorsConfig
-{
-    // ADC settings
-    uint8_t adcBits;
-    float adcRefV;
-    uint16_t adcMax;
-
-    // Temperature calibration
-    const TempVPoint* tempVTable;
-    size_t tempVTableSize;
-    int tempMinC;
-    int tempMaxC;
-
-    // Fuel calibration
-    float fuelAdcVMin; // empty
-    float fuelAdcVMax; // full
-};
+struct AnalogLut; // AnalogLut.h
 
 class AnalogSensors
 {
@@ -41,25 +22,85 @@ public:
         uint8_t fuel; // ADC pin for fuel sender
     };
 
-    AnalogSensors(const Pins &pins, const AnalogSensorsConfig &config);
+    // lut: optional compile-time table (makeAnalogLut); without it the
+    // same conversions run in float, once per update()
+    AnalogSensors(const Pins &pins, const AnalogSensorsConfig &config,
+                  const AnalogLut *lut = nullptr);
 
+    // Sample through the continuous DMA stream instead of analogRead()
+    // (call before begin; start the stream after begin)
+    void setStream(AdcStream &stream);
+
+    // Also pre-warms the filters from a short burst of reads, so the
+    // gauges are right before the first update()
     void begin();
     void update();
 
+    // Start the fuel filter at a persisted level when the boot burst
+    // agrees within tolerancePct – hides slosh / cranking sag at power-on.
+    // A refuelled tank disagrees and keeps the burst value.
+    bool restoreFuelPercent(uint8_t pct, uint8_t tolerancePct);
+
+    // Latest unfiltered reading in adcMax counts (fractional when
+    // oversampled)
+    float tempRaw() const { return tempLast / (float)(1 << Q); }
+    float fuelRaw() const { return fuelLast / (float)(1 << Q); }
+
+    // Converted once per update(); accessors are plain loads
+
     // Engine temperature
-    int16_t tempC() const;       // real temperature
-    uint8_t tempPercent() const; // mapped for display
+    int16_t tempC() const { return tempCached; }         // real temperature
+    uint8_t tempPercent() const { return tempPctCached; } // mapped for display
 
     // Fuel
-    uint8_t fuelPercent() const;
+    uint8_t fuelPercent() const { return fuelPctCached; }
 
 private:
     Pins pins;
     AnalogSensorsConfig config;
+    const AnalogLut *lut;
+
+    // Filtering runs on ADC counts × 2^Q. Median drops wiring spikes, the
+    // EMA time constant is in ms, and a 4-count hysteresis keeps the LUT
+    // index from toggling between neighbours.
+    static constexpr uint8_t Q = 4;
+    using TempChain = FilterChain<MedianFilter<5>, EmaFilter<1000>, HysteresisFilter<(4 << Q)>>;
+    using FuelChain = FilterChain<MedianFilter<5>, EmaFilter<4000>, HysteresisFilter<(4 << Q)>>; // slosh
+
+    TempChain tempChain;
+    FuelChain fuelChain;
+
+    int32_t tempFiltered = 0;
+    int32_t fuelFiltered = 0;
+
+    int32_t tempLast = 0;
+    int32_t fuelLast = 0;
+
+    uint32_t tempUs = 0;
+    uint32_t fuelUs = 0;
+
+    AdcStream *stream = nullptr;
+    int8_t tempSlot = -1;
+    int8_t fuelSlot = -1;
+    uint16_t tempSeq = 0;
+    uint16_t fuelSeq = 0;
+
+    static constexpr uint8_t WARMUP_SAMPLES = 31;
+
+    bool warmedUp = false;
+    int32_t burstMedian(uint8_t pin) const;
+
+    template <typename Chain>
+    void seed(Chain &chain, int32_t &filtered, int32_t &last, uint32_t &lastUs, int32_t raw);
+
+    bool nextSample(int8_t slot, uint16_t &seq, uint8_t pin, int32_t &raw);
 
-    float tempFiltered = 0.0f;
-    float fuelFiltered = 0.0f;
+    template <typename Chain>
+    void filter(Chain &chain, int32_t &filtered, int32_t &last, uint32_t &lastUs, int32_t raw);
+    void convert();
 
-    int interpolateTempFromVoltage(float voltage) const;
+    int16_t tempCached = 0;
+    uint8_t tempPctCached = 0;
+    uint8_t fuelPctCached = 0;
 };
 #endif // NINA_ANALOGSENSORS_H
\ No newline at end of file
@@ -3,25 +3,64 @@
 DashLights::DashLights(Multiplex<1> &mux)
     : multiplex(mux) {}
 
-void DashLights::begin()
+bool DashLights::begin()
 {
-    multiplex.setRenderer(render, this);
-    multiplex.start();
+    multiplex.enableFrameCache();
+    return multiplex.start();
 }
 
 void DashLights::setLight(Light light, bool on)
 {
-    bitWrite(shiftState, light, on);
+    uint8_t next = shiftState;
+    bitWrite(next, light, on);
+    if (next == shiftState)
+        return; // unchanged – chain is not re-shifted
+
+    shiftState = next;
+
+    if (liveMask & (1 << light))
+    {
+        multiplex.setLive(0, 0, on ? 1 << light : 0, 1 << light);
+        return;
+    }
+
+    publishImage();
+}
+
+void DashLights::publishImage()
+{
+    // One register, one byte — exactly like old shiftOut.
+    // Live lights are always drawn; their gate decides.
+    multiplex.backFrame(0)[0] = shiftState | liveMask;
+    multiplex.publish();
+}
+
+void DashLights::enableLive(uint8_t lightMask)
+{
+    liveMask = lightMask;
+    multiplex.setLive(0, 0, shiftState | ~lightMask, 0xFF); // others ungated
+    publishImage();
+}
+
+void IRAM_ATTR DashLights::setLiveLights(uint8_t on, uint8_t mask, uint32_t stampUs)
+{
+    // Light bit = latency source
+    multiplex.setLive(0, 0, on, mask & liveMask, stampUs, mask & liveMask);
+}
+
+Multiplex<1>::LiveLatency DashLights::liveLatency(Light light) const
+{
+    return multiplex.liveLatency(light);
 }
 
-void DashLights::render(uint8_t channel, void *ctx, uint8_t *regs)
+void DashLights::setLightPattern(Light light, MuxPattern pattern)
 {
-    auto *self = static_cast<DashLights *>(ctx);
-    if (channel != 0)
+    if (patterns[light] == pattern)
         return;
 
-    // One register, one byte — exactly like old shiftOut
-    regs[0] = self->shiftState;
+    patterns[light] = pattern;
+    multiplex.setPattern(0, light, pattern);
+    multiplex.publish();
 }
 
 // Convenience wrappers
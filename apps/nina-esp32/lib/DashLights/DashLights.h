@@ -23,10 +23,26 @@ public:
 
     DashLights(Multiplex<1> &mux);
 
-    void begin();
+    // false if the chain has no refresh source (see Multiplex::start)
+    bool begin();
 
     void setLight(Light light, bool on);
 
+    // Lights in lightMask are switched through the refresh ISR's live gate
+    // instead of a published frame, so setLiveLights() can drive them
+    // straight from an input interrupt. setLight() keeps working for them.
+    void enableLive(uint8_t lightMask);
+
+    // ISR-safe. on/mask are Light bits; stampUs = micros() of the cause.
+    // The gate only switches a light on/off – its pattern still applies.
+    void IRAM_ATTR setLiveLights(uint8_t on, uint8_t mask, uint32_t stampUs);
+
+    // Cause → latched, per live light
+    Multiplex<1>::LiveLatency liveLatency(Light light) const;
+
+    // Blink a warning light from the refresh ISR (Steady = plain on/off)
+    void setLightPattern(Light light, MuxPattern pattern);
+
     // Convenience
     void setOil(bool on);
     void setBrakes(bool on);
@@ -38,10 +54,11 @@ public:
     void setHighBeam(bool on);
 
 private:
-    // 🔥 UPDATED
-    static void render(uint8_t channel, void *ctx, uint8_t *regs);
+    void publishImage();
 
     uint8_t shiftState = 0;
+    uint8_t liveMask = 0;
+    MuxPattern patterns[8]{};
     Multiplex<1> &multiplex;
 };
 
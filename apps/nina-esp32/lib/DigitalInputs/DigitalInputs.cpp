@@ -3,9 +3,46 @@
 //
 
 #include "DigitalInputs.h"
+#include <soc/gpio_struct.h>
 
-DigitalInputs::DigitalInputs(const Pins& pins)
-  : pins(pins) {}
+DigitalInputs::DigitalInputs(const Pins& pins, const PinMap& map, uint8_t sampleMs)
+  : lockoutUs(4000UL * sampleMs), pins(pins), map(map), sampleMs(sampleMs) {}
+
+void DigitalInputs::enableEvents(EdgeHook h, void* ctx, Mask live) {
+    eventMode = true;
+    hook = h;
+    hookCtx = ctx;
+    liveInputs = h ? live & ALL : 0;
+}
+
+// One ISR for every input pin: any edge snapshots all of them. The map
+// lives in flash; fine, the Arduino GPIO ISR service is not IRAM-only.
+void IRAM_ATTR DigitalInputs::isr(void* arg) {
+    DigitalInputs* self = static_cast<DigitalInputs*>(arg);
+
+    uint32_t us = micros();
+    Mask level = self->readRaw();
+
+    // Latency-critical first: leading edges of live pins that are not
+    // locked out. A bounce inside the lockout is ignored here and left
+    // to the debouncer.
+    portENTER_CRITICAL_ISR(&self->liveLock);
+    Mask edges = (level ^ self->liveLevel) & self->liveInputs;
+    Mask accepted = 0;
+    for (uint8_t i = 0; edges; i++, edges >>= 1) {
+        if ((edges & 1) && us - self->liveEdgeUs[i] >= self->lockoutUs) {
+            accepted |= 1 << i;
+            self->liveEdgeUs[i] = us;
+        }
+    }
+    if (accepted) {
+        self->liveLevel ^= accepted;
+        self->hook(self->hookCtx, self->liveLevel, accepted, us);
+    }
+    portEXIT_CRITICAL_ISR(&self->liveLock);
+
+    self->events.push({us, level});
+}
 
 void DigitalInputs::begin() {
     pinMode(pins.brake,      INPUT_PULLUP);
@@ -15,22 +52,119 @@ void DigitalInputs::begin() {
     pinMode(pins.lights,     INPUT_PULLUP);
     pinMode(pins.fog,        INPUT_PULLUP);
     pinMode(pins.battery,    INPUT_PULLUP);
+
+    // Start from the current levels – no "changes" at boot
+    debounce.reset(readRaw());
+    lastSampleMs = millis();
+
+    indLevel = state() & (1 << INDICATORS);
+    liveLevel = state() & liveInputs;
+
+    if (eventMode) {
+        const uint8_t gpio[INPUT_COUNT] = {
+            pins.brake, pins.oil, pins.indicators, pins.highBeam,
+            pins.lights, pins.fog, pins.battery};
+
+        // Live pins, plus the indicator for its flash timing
+        Mask irqInputs = liveInputs | (1 << INDICATORS);
+        for (uint8_t i = 0; i < INPUT_COUNT; i++) {
+            if (irqInputs & (1 << i))
+                attachInterruptArg(digitalPinToInterrupt(gpio[i]), isr, this, CHANGE);
+        }
+    }
+}
+
+DigitalInputs::Mask IRAM_ATTR DigitalInputs::readRaw() const {
+    uint32_t in0 = GPIO.in;
+    uint32_t in1 = GPIO.in1.data;
+
+    Mask level = map.lane[0][in0 & 0xFF] |
+                 map.lane[1][(in0 >> 8) & 0xFF] |
+                 map.lane[2][(in0 >> 16) & 0xFF] |
+                 map.lane[3][in0 >> 24] |
+                 map.lane[4][in1 & 0xFF];
+
+    // Pulled up, switched to ground: low = active
+    return ~level & ALL;
 }
 
 void DigitalInputs::update() {
-    brakeState      = !digitalRead(pins.brake);
-    oilState        = !digitalRead(pins.oil);
-    indicatorsState = !digitalRead(pins.indicators);
-    highBeamState   = !digitalRead(pins.highBeam);
-    lightsState     = !digitalRead(pins.lights);
-    fogState        = !digitalRead(pins.fog);
-    batteryState    = !digitalRead(pins.battery);
-}
-
-bool DigitalInputs::brake() const      { return brakeState; }
-bool DigitalInputs::oil() const        { return oilState; }
-bool DigitalInputs::indicators() const { return indicatorsState; }
-bool DigitalInputs::highBeam() const   { return highBeamState; }
-bool DigitalInputs::lights() const     { return lightsState; }
-bool DigitalInputs::fog() const        { return fogState; }
-bool DigitalInputs::battery() const    { return batteryState; }
\ No newline at end of file
+    lastChanged = 0;
+
+    if (eventMode)
+        drainEvents();
+
+    uint32_t now = millis();
+    if (now - lastSampleMs < sampleMs)
+        return;
+    lastSampleMs = now;
+
+    lastChanged = debounce.sample(readRaw());
+
+    if (liveInputs)
+        resyncLive();
+}
+
+// The ISR only ever sees edges: a glitch shorter than the lockout leaves
+// the live gate on its leading level. Put settled pins back on the
+// debounced state – after twice the lockout, so a real edge's bounce
+// plus four samples has passed and the debouncer already agrees.
+void DigitalInputs::resyncLive() {
+    uint32_t us = micros();
+
+    portENTER_CRITICAL(&liveLock);
+    Mask stale = (liveLevel ^ state()) & liveInputs;
+    Mask fixed = 0;
+    for (uint8_t i = 0; stale; i++, stale >>= 1) {
+        if ((stale & 1) && us - liveEdgeUs[i] >= 2 * lockoutUs)
+            fixed |= 1 << i;
+    }
+    if (fixed) {
+        liveLevel ^= fixed;
+        hook(hookCtx, liveLevel, fixed, 0);
+    }
+    portEXIT_CRITICAL(&liveLock);
+}
+
+void DigitalInputs::drainEvents() {
+    Event e;
+    while (events.pop(e))
+        timeIndicator(e);
+}
+
+void DigitalInputs::timeIndicator(const Event& e) {
+    bool level = e.level & (1 << INDICATORS);
+    if (level == indLevel)
+        return; // edge on another input, or a bounce back
+
+    uint32_t sinceUs = e.us - indEdgeUs;
+    if (indHaveEdge && sinceUs < 4000UL * sampleMs)
+        return; // bounce: timing runs from the leading edge
+
+    uint32_t sinceMs = sinceUs / 1000;
+    bool inFlash = indHaveEdge && sinceMs < FLASH_GAP_MS;
+
+    if (level) {
+        if (inFlash)
+            flash.offMs = sinceMs;
+
+        uint32_t periodMs = (e.us - indRiseUs) / 1000;
+        if (indHaveRise && periodMs < FLASH_GAP_MS) {
+            flash.periodMs = periodMs;
+            if (flash.flashes == 0 || periodMs < flash.minPeriodMs)
+                flash.minPeriodMs = periodMs;
+            if (periodMs > flash.maxPeriodMs)
+                flash.maxPeriodMs = periodMs;
+            flash.flashes++;
+        }
+
+        indRiseUs = e.us;
+        indHaveRise = true;
+    } else if (inFlash) {
+        flash.onMs = sinceMs;
+    }
+
+    indLevel = level;
+    indEdgeUs = e.us;
+    indHaveEdge = true;
+}
@@ -8,7 +8,20 @@
 
 #pragma once
 #include <Arduino.h>
+#include <SpscRing.h>
+#include "VerticalDebounce.h"
 
+// All inputs are sampled with two GPIO register loads (GPIO0–31, 32–39),
+// packed into one word through per-byte lookup tables built at compile
+// time, and debounced together by vertical counters.
+//
+// Event mode adds a CHANGE interrupt per pin: the ISR snapshots all inputs
+// with a timestamp and queues the event. Live inputs also drive an
+// optional hook (e.g. the dash-light live gate): the leading edge passes
+// at once, then that pin is locked out for the debounce time so contact
+// bounce never reaches the hook. The polled, debounced state() stays
+// authoritative – once a pin has settled, update() hands the hook the
+// debounced level if the two disagree (a glitch).
 class DigitalInputs {
 public:
     struct Pins {
@@ -21,29 +34,139 @@ public:
         uint8_t battery;
     };
 
-    explicit DigitalInputs(const Pins& pins);
+    // Bit positions in state() / changed(), in Pins order
+    enum Input : uint8_t {
+        BRAKE = 0,
+        OIL,
+        INDICATORS,
+        HIGH_BEAM,
+        LIGHTS,
+        FOG,
+        BATTERY,
+        INPUT_COUNT
+    };
+
+    using Mask = uint8_t;
+    static constexpr Mask ALL = (1 << INPUT_COUNT) - 1;
+
+    // Register byte → packed input bits. Lanes 0–3 are the bytes of
+    // GPIO.in, lane 4 is GPIO.in1 (GPIO32–39).
+    static constexpr uint8_t LANES = 5;
+    struct PinMap {
+        Mask lane[LANES][256];
+    };
+
+    // Build with: constexpr auto map = DigitalInputs::makePinMap(pins);
+    static constexpr PinMap makePinMap(const Pins& pins) {
+        const uint8_t gpio[INPUT_COUNT] = {
+            pins.brake, pins.oil, pins.indicators, pins.highBeam,
+            pins.lights, pins.fog, pins.battery};
+
+        PinMap map{};
+        for (uint8_t i = 0; i < INPUT_COUNT; i++) {
+            uint8_t l = gpio[i] / 8; // GPIO > 39 fails to compile here
+            uint8_t bit = gpio[i] % 8;
+
+            for (uint16_t b = 0; b < 256; b++) {
+                if (b & (1 << bit))
+                    map.lane[l][b] |= 1 << i;
+            }
+        }
+        return map;
+    }
+
+    // sampleMs: debounce sample spacing; a change must hold for four
+    // samples (3–4 × sampleMs) to be accepted
+    DigitalInputs(const Pins& pins, const PinMap& map, uint8_t sampleMs = 5);
+
+    // Raw (undebounced) levels from the edge ISR; us = micros() at entry
+    struct Event {
+        uint32_t us;
+        Mask level;
+    };
+
+    // Runs inside the GPIO ISR (and from update() on resync, us = 0) –
+    // keep it short and in IRAM. Only the `changed` bits are news.
+    using EdgeHook = void (*)(void* ctx, Mask level, Mask changed, uint32_t us);
+
+    // Call before begin(). liveInputs: the inputs that need sub-ms
+    // latency; only they reach the hook.
+    void enableEvents(EdgeHook hook = nullptr, void* ctx = nullptr, Mask liveInputs = ALL);
 
     void begin();
     void update();
 
-    bool brake() const;
-    bool oil() const;
-    bool indicators() const;
-    bool highBeam() const;
-    bool lights() const;
-    bool fog() const;
-    bool battery() const;
+    // Turn-signal timing from the event timestamps (leading edges,
+    // bounces inside the debounce time ignored)
+    struct FlashTiming {
+        uint16_t onMs;
+        uint16_t offMs;
+        uint16_t periodMs;
+        uint16_t minPeriodMs;
+        uint16_t maxPeriodMs;
+        uint32_t flashes;
+    };
+    const FlashTiming& indicatorTiming() const { return flash; }
+
+    uint32_t edgeEvents() const { return events.pushed(); }
+    uint32_t droppedEvents() const { return events.dropped(); }
+
+    // Debounced inputs, active = 1, bit = Input
+    Mask state() const { return debounce.value(); }
+
+    // Bits that flipped during the last update() (0 between samples)
+    Mask changed() const { return lastChanged; }
+
+    bool brake() const      { return state() & (1 << BRAKE); }
+    bool oil() const        { return state() & (1 << OIL); }
+    bool indicators() const { return state() & (1 << INDICATORS); }
+    bool highBeam() const   { return state() & (1 << HIGH_BEAM); }
+    bool lights() const     { return state() & (1 << LIGHTS); }
+    bool fog() const        { return state() & (1 << FOG); }
+    bool battery() const    { return state() & (1 << BATTERY); }
 
 private:
+    static_assert(INPUT_COUNT <= sizeof(Mask) * 8, "Mask too narrow");
+
+    // Raw, undebounced snapshot (active = 1)
+    Mask IRAM_ATTR readRaw() const;
+
+    // ~1 s of flashing with bounce; overflow only costs diagnostics
+    static constexpr uint32_t EVENT_RING = 32;
+    static constexpr uint16_t FLASH_GAP_MS = 2000; // longer = signal was off
+
+    static void IRAM_ATTR isr(void* arg);
+    void drainEvents();
+    void resyncLive();
+    void timeIndicator(const Event& e);
+
+    SpscRing<Event, EVENT_RING> events;
+    bool eventMode = false;
+    EdgeHook hook = nullptr;
+    void* hookCtx = nullptr;
+
+    // Live gate as last handed to the hook, and each pin's last accepted
+    // edge. Shared with the ISR under liveLock.
+    Mask liveInputs = 0;
+    Mask liveLevel = 0;
+    uint32_t liveEdgeUs[INPUT_COUNT] = {};
+    uint32_t lockoutUs;
+    portMUX_TYPE liveLock = portMUX_INITIALIZER_UNLOCKED;
+
+    FlashTiming flash{};
+    bool indLevel = false;
+    bool indHaveEdge = false;
+    bool indHaveRise = false;
+    uint32_t indEdgeUs = 0;
+    uint32_t indRiseUs = 0;
+
     Pins pins;
+    const PinMap& map;
+    uint8_t sampleMs;
 
-    bool brakeState = false;
-    bool oilState = false;
-    bool indicatorsState = false;
-    bool highBeamState = false;
-    bool lightsState = false;
-    bool fogState = false;
-    bool batteryState = false;
+    VerticalDebounce<Mask> debounce;
+    Mask lastChanged = 0;
+    uint32_t lastSampleMs = 0;
 };
 
-#endif //NINA_DIGITALINPUTS_H
\ No newline at end of file
+#endif //NINA_DIGITALINPUTS_H
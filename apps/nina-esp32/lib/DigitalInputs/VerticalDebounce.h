@@ -0,0 +1,43 @@
+//
+// Bit-parallel debouncer: one 2-bit counter per bit, held "vertically"
+// in two words, so every channel is filtered by the same few bitwise ops.
+//
+
+#ifndef NINA_VERTICALDEBOUNCE_H
+#define NINA_VERTICALDEBOUNCE_H
+
+#pragma once
+#include <stdint.h>
+
+template <typename Mask>
+class VerticalDebounce {
+public:
+    // Start from a known level, no transition pending
+    void reset(Mask level) {
+        state = level;
+        cnt0 = 0;
+        cnt1 = 0;
+    }
+
+    // A bit flips after 4 consecutive samples disagreeing with it; any
+    // agreeing sample restarts its count. Returns the bits that flipped.
+    Mask sample(Mask raw) {
+        Mask delta = raw ^ state;
+
+        cnt1 = (cnt1 ^ cnt0) & delta;
+        cnt0 = ~cnt0 & delta;
+
+        Mask toggle = delta & ~(cnt0 | cnt1); // counter wrapped to 0
+        state ^= toggle;
+        return toggle;
+    }
+
+    Mask value() const { return state; }
+
+private:
+    Mask state = 0;
+    Mask cnt0 = 0;
+    Mask cnt1 = 0;
+};
+
+#endif //NINA_VERTICALDEBOUNCE_H
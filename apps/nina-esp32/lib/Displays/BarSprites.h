@@ -0,0 +1,154 @@
+//
+// Pre-rendered frames for segmented bar gauges
+//
+
+#ifndef NINA_BARSPRITES_H
+#define NINA_BARSPRITES_H
+
+#pragma once
+
+#include <Arduino.h>
+
+// A bar widget has only segments + 1 looks, so every one of them is
+// rasterized at compile time straight into SSD1306 page layout (byte =
+// 8 vertical pixels, LSB on top, pages of `width` bytes). Showing a
+// value is then one memcpy into the display buffer; displayChanged()
+// diffs it against the panel as usual.
+//
+// The primitives follow Adafruit_GFX (rotation 0) pixel for pixel, so
+// the frames match what drawRoundRect/fillRect/drawBitmap used to draw.
+
+// 1-bit bitmap, rows MSB first (drawBitmap() format)
+struct SpriteBitmap {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+    const uint8_t* bits;
+};
+
+struct BarStyle {
+    // Outline (drawRoundRect)
+    int16_t frameX, frameY, frameW, frameH, frameR;
+
+    // Segment i covers segX + i * segPitch .. + segW
+    int16_t segX, segY, segW, segH, segPitch;
+
+    // Scale, labels – drawn on every frame
+    const SpriteBitmap* decor;
+    uint8_t decorCount;
+};
+
+template <uint8_t WIDTH, uint8_t HEIGHT, uint8_t SEGMENTS>
+struct BarSprites {
+    static constexpr uint8_t FRAMES = SEGMENTS + 1;
+    static constexpr uint16_t FRAME_BYTES = WIDTH * ((HEIGHT + 7) / 8);
+
+    uint8_t frame[FRAMES][FRAME_BYTES];
+
+    // Frame with `lit` segments on (clamped)
+    const uint8_t* operator[](uint8_t lit) const { return frame[lit > SEGMENTS ? SEGMENTS : lit]; }
+};
+
+namespace sprite {
+
+template <uint8_t WIDTH, uint8_t HEIGHT>
+constexpr void pixel(uint8_t* buf, int16_t x, int16_t y) {
+    if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) return;
+    buf[x + (y / 8) * WIDTH] |= 1 << (y & 7);
+}
+
+template <uint8_t WIDTH, uint8_t HEIGHT>
+constexpr void fillRect(uint8_t* buf, int16_t x, int16_t y, int16_t w, int16_t h) {
+    for (int16_t j = y; j < y + h; j++)
+        for (int16_t i = x; i < x + w; i++)
+            pixel<WIDTH, HEIGHT>(buf, i, j);
+}
+
+// Adafruit_GFX::drawCircleHelper
+template <uint8_t WIDTH, uint8_t HEIGHT>
+constexpr void corner(uint8_t* buf, int16_t x0, int16_t y0, int16_t r, uint8_t which) {
+    int16_t f = 1 - r;
+    int16_t ddFx = 1;
+    int16_t ddFy = -2 * r;
+    int16_t x = 0;
+    int16_t y = r;
+
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddFy += 2;
+            f += ddFy;
+        }
+        x++;
+        ddFx += 2;
+        f += ddFx;
+
+        if (which & 0x4) {
+            pixel<WIDTH, HEIGHT>(buf, x0 + x, y0 + y);
+            pixel<WIDTH, HEIGHT>(buf, x0 + y, y0 + x);
+        }
+        if (which & 0x2) {
+            pixel<WIDTH, HEIGHT>(buf, x0 + x, y0 - y);
+            pixel<WIDTH, HEIGHT>(buf, x0 + y, y0 - x);
+        }
+        if (which & 0x8) {
+            pixel<WIDTH, HEIGHT>(buf, x0 - y, y0 + x);
+            pixel<WIDTH, HEIGHT>(buf, x0 - x, y0 + y);
+        }
+        if (which & 0x1) {
+            pixel<WIDTH, HEIGHT>(buf, x0 - y, y0 - x);
+            pixel<WIDTH, HEIGHT>(buf, x0 - x, y0 - y);
+        }
+    }
+}
+
+// Adafruit_GFX::drawRoundRect
+template <uint8_t WIDTH, uint8_t HEIGHT>
+constexpr void roundRect(uint8_t* buf, int16_t x, int16_t y, int16_t w, int16_t h, int16_t r) {
+    int16_t maxR = (w < h ? w : h) / 2;
+    if (r > maxR) r = maxR;
+
+    fillRect<WIDTH, HEIGHT>(buf, x + r, y, w - 2 * r, 1);         // top
+    fillRect<WIDTH, HEIGHT>(buf, x + r, y + h - 1, w - 2 * r, 1); // bottom
+    fillRect<WIDTH, HEIGHT>(buf, x, y + r, 1, h - 2 * r);         // left
+    fillRect<WIDTH, HEIGHT>(buf, x + w - 1, y + r, 1, h - 2 * r); // right
+
+    corner<WIDTH, HEIGHT>(buf, x + r, y + r, r, 1);
+    corner<WIDTH, HEIGHT>(buf, x + w - r - 1, y + r, r, 2);
+    corner<WIDTH, HEIGHT>(buf, x + w - r - 1, y + h - r - 1, r, 4);
+    corner<WIDTH, HEIGHT>(buf, x + r, y + h - r - 1, r, 8);
+}
+
+// Adafruit_GFX::drawBitmap, transparent background
+template <uint8_t WIDTH, uint8_t HEIGHT>
+constexpr void bitmap(uint8_t* buf, const SpriteBitmap& b) {
+    int16_t byteWidth = (b.w + 7) / 8;
+    for (int16_t j = 0; j < b.h; j++)
+        for (int16_t i = 0; i < b.w; i++)
+            if (b.bits[j * byteWidth + i / 8] & (0x80 >> (i & 7)))
+                pixel<WIDTH, HEIGHT>(buf, b.x + i, b.y + j);
+}
+
+} // namespace sprite
+
+template <uint8_t WIDTH, uint8_t HEIGHT, uint8_t SEGMENTS>
+constexpr BarSprites<WIDTH, HEIGHT, SEGMENTS> makeBarSprites(const BarStyle& s) {
+    BarSprites<WIDTH, HEIGHT, SEGMENTS> sheet{};
+
+    for (uint8_t lit = 0; lit <= SEGMENTS; lit++) {
+        uint8_t* buf = sheet.frame[lit];
+
+        sprite::roundRect<WIDTH, HEIGHT>(buf, s.frameX, s.frameY, s.frameW, s.frameH, s.frameR);
+
+        for (uint8_t i = 0; i < lit; i++)
+            sprite::fillRect<WIDTH, HEIGHT>(buf, s.segX + s.segPitch * i, s.segY, s.segW, s.segH);
+
+        for (uint8_t d = 0; d < s.decorCount; d++)
+            sprite::bitmap<WIDTH, HEIGHT>(buf, s.decor[d]);
+    }
+
+    return sheet;
+}
+
+#endif //NINA_BARSPRITES_H
@@ -3,25 +3,45 @@
 //
 
 #include "Displays.h"
+#include "BarSprites.h"
 
 #define W 128
 #define H 32
 
-// Bitmaps (unchanged)
-static const unsigned char PROGMEM image_Layer_14_bits[] = { 0xf8, 0x20, 0xf8 };
-static const unsigned char PROGMEM image_Layer_14_1_bits[] = {
+// Gauge artwork – only read at compile time, baked into gaugeSprites
+static constexpr uint8_t image_Layer_14_bits[] = { 0xf8, 0x20, 0xf8 };
+static constexpr uint8_t image_Layer_14_1_bits[] = {
     0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
     0xff,0xff,0xff,0x80,0x00,0x00,0x00,0x00,0x00,0x00,0x18,0x00,
     0x00,0x00,0x00,0x00,0x00,0x01,0x80,0x00,0x00,0x00,0x00,0x00,
     0x00,0x18,0x00,0x00,0x00,0x00,0x00,0x00,0x01,0x80,0x00,0x00,
     0x00,0x00,0x00,0x00,0x18,0x00,0x00,0x00,0x00,0x00,0x00,0x01
   };
-static const unsigned char PROGMEM image_Layer_15_bits[] = { 0x70, 0x88, 0x50 };
+static constexpr uint8_t image_Layer_15_bits[] = { 0x70, 0x88, 0x50 };
+
+static constexpr SpriteBitmap gaugeDecor[] = {
+    { 121, 29, 5, 3, image_Layer_14_bits },   // F / H marker
+    { 4, 24, 120, 4, image_Layer_14_1_bits }, // scale
+    { 2, 29, 5, 3, image_Layer_15_bits },     // E / C marker
+};
+
+// Rounded outline, ten 10 px segments every 12 px
+static constexpr BarStyle gaugeStyle = {
+    1, 1, 126, 22, 3,
+    5, 4, 10, 16, 12,
+    gaugeDecor, sizeof(gaugeDecor) / sizeof(gaugeDecor[0])
+};
+
+static constexpr uint8_t GAUGE_SEGMENTS = 10;
+
+// 11 frames × 512 B, in flash
+static constexpr BarSprites<W, H, GAUGE_SEGMENTS> gaugeSprites =
+    makeBarSprites<W, H, GAUGE_SEGMENTS>(gaugeStyle);
 
 Displays::Displays(
-  Adafruit_SSD1306& fuelDisplay,
-  Adafruit_SSD1306& tempDisplay,
-  Adafruit_SSD1306* mainOledDisplayPtr
+  PartialSSD1306& fuelDisplay,
+  PartialSSD1306& tempDisplay,
+  PartialSSD1306* mainOledDisplayPtr
 )
   : fuel(fuelDisplay),
     temp(tempDisplay),
@@ -36,43 +56,131 @@ void Displays::begin(bool mainOledAvailable, bool fuelOledAvailable, bool tempOl
     // Only initialize displays that are connected
     if (fuelOledConnected) {
         fuel.clearDisplay();
-        fuel.display();
+        fuel.displayAll();
     }
     
     if (tempOledConnected) {
         temp.clearDisplay();
-        temp.display();
+        temp.displayAll();
     }
     
     if (mainOledConnected && mainOled != nullptr) {
         mainOled->clearDisplay();
-        mainOled->display();
+        mainOled->displayAll();
     }
 }
 
-void Displays::drawBar(Adafruit_SSD1306& disp, uint8_t pct) {
-    disp.clearDisplay();
-    disp.drawRoundRect(1, 1, 126, 22, 3, SSD1306_WHITE);
+void Displays::setContrast(uint8_t value) {
+    if (value == contrast) return;
+    contrast = value;
 
-    uint8_t bars = (pct * 10) / 100;
-    for (uint8_t i = 0; i < bars; i++) {
-        disp.fillRect(5 + 12 * i, 4, 10, 16, SSD1306_WHITE);
+    const uint8_t cmds[] = {SSD1306_SETCONTRAST, value};
+
+    if (fuelOledConnected) {
+        fuel.command(cmds, sizeof(cmds));
     }
 
-    disp.drawBitmap(121, 29, image_Layer_14_bits, 5, 3, SSD1306_WHITE);
-    disp.drawBitmap(4, 24, image_Layer_14_1_bits, 120, 4, SSD1306_WHITE);
-    disp.drawBitmap(2, 29, image_Layer_15_bits, 5, 3, SSD1306_WHITE);
+    if (tempOledConnected) {
+        temp.command(cmds, sizeof(cmds));
+    }
 
-    disp.display();
+    if (mainOledConnected && mainOled != nullptr) {
+        mainOled->command(cmds, sizeof(cmds));
+    }
+}
+
+bool Displays::startTask(BaseType_t core, UBaseType_t priority, uint32_t minFrameMs, uint32_t stackBytes) {
+    if (task) return true;
+
+    mailbox = xQueueCreate(1, sizeof(Snapshot));
+    if (!mailbox) return false;
+
+    frameTicks = pdMS_TO_TICKS(minFrameMs);
+
+    if (xTaskCreatePinnedToCore(taskEntry, "displays", stackBytes, this, priority, &task, core) != pdPASS) {
+        vQueueDelete(mailbox);
+        mailbox = nullptr;
+        task = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void Displays::post(const Snapshot& snapshot) {
+    renderStat.posted++;
+
+    if (!task) {
+        render(snapshot);
+        return;
+    }
+
+    // Copies ~28 bytes under the queue lock; a stale frame is simply lost
+    xQueueOverwrite(mailbox, &snapshot);
+}
+
+void Displays::taskEntry(void* arg) {
+    static_cast<Displays*>(arg)->runTask();
+}
+
+void Displays::runTask() {
+    Snapshot s;
+
+    for (;;) {
+        if (xQueueReceive(mailbox, &s, portMAX_DELAY) != pdTRUE) continue;
+
+        TickType_t startTick = xTaskGetTickCount();
+        uint32_t startUs = micros();
+
+        render(s);
+
+        uint32_t us = micros() - startUs;
+        renderStat.lastUs = us;
+        if (us > renderStat.maxUs) renderStat.maxUs = us;
+
+        // Pace: whatever is posted meanwhile waits, and only the newest
+        // survives to the next frame
+        TickType_t spent = xTaskGetTickCount() - startTick;
+        if (spent < frameTicks) vTaskDelay(frameTicks - spent);
+    }
+}
+
+void Displays::render(const Snapshot& s) {
+    setContrast(s.contrast);
+    showFuel(s.fuelPct);
+    showTemp(s.tempPct);
+
+    if (s.screen == Screen::Trip) {
+        showTrip(s.trip.avgKph, s.trip.maxKph, s.trip.maxRpm, s.trip.maxCoolantC,
+                 s.trip.movingMin, s.trip.idleMin);
+    } else {
+        showOdometer(s.odometerKm, s.tripKm);
+    }
+
+    renderStat.rendered++;
+}
+
+void Displays::drawBar(PartialSSD1306& disp, uint8_t pct) {
+    if (disp.width() != W || disp.height() != H) return; // sprites are 128x32
+
+    // Whole frame from the sprite sheet; only the segments that changed
+    // go over I2C
+    uint8_t bars = (pct * GAUGE_SEGMENTS) / 100;
+    memcpy(disp.getBuffer(), gaugeSprites[bars], gaugeSprites.FRAME_BYTES);
+
+    disp.displayChanged();
 }
 
 void Displays::showFuel(uint8_t pct) {
     if (!fuelOledConnected) return; // Skip if Fuel OLED not connected
+    if (pct == fuelShown) return;   // Same frame – nothing to draw or send
+    fuelShown = pct;
     drawBar(fuel, pct);
 }
 
 void Displays::showTemp(uint8_t pct) {
     if (!tempOledConnected) return; // Skip if Temp OLED not connected
+    if (pct == tempShown) return;
+    tempShown = pct;
     drawBar(temp, pct);
 }
 
@@ -84,7 +192,7 @@ void Displays::showText(const char* line1) {
     mainOled->setTextColor(SSD1306_WHITE);
     mainOled->setCursor(0, 0);
     mainOled->println(line1);
-    mainOled->display();
+    mainOled->displayChanged();
 }
 
 void Displays::showText(const char* line1, const char* line2) {
@@ -97,7 +205,7 @@ void Displays::showText(const char* line1, const char* line2) {
     mainOled->println(line1);
     mainOled->setCursor(0, 16);
     mainOled->println(line2);
-    mainOled->display();
+    mainOled->displayChanged();
 }
 
 void Displays::showText(const char* line1, const char* line2, const char* line3) {
@@ -112,7 +220,7 @@ void Displays::showText(const char* line1, const char* line2, const char* line3)
     mainOled->println(line2);
     mainOled->setCursor(0, 32);
     mainOled->println(line3);
-    mainOled->display();
+    mainOled->displayChanged();
 }
 
 void Displays::showText(const char* line1, const char* line2, const char* line3, const char* line4) {
@@ -129,7 +237,7 @@ void Displays::showText(const char* line1, const char* line2, const char* line3,
     mainOled->println(line3);
     mainOled->setCursor(0, 48);
     mainOled->println(line4);
-    mainOled->display();
+    mainOled->displayChanged();
 }
 
 void Displays::showOdometer(uint32_t km, uint32_t tripKm) {
@@ -185,5 +293,47 @@ void Displays::showOdometer(uint32_t km, uint32_t tripKm) {
     mainOled->setCursor(60, 55);
     mainOled->print(kmStr);
     
-    mainOled->display();
-}
\ No newline at end of file
+    mainOled->displayChanged();
+}
+void Displays::showTrip(
+    uint16_t avgKph,
+    uint16_t maxKph,
+    uint16_t maxRpm,
+    int16_t maxCoolantC,
+    uint32_t movingMin,
+    uint32_t idleMin) {
+    if (!mainOledConnected || mainOled == nullptr) return;
+
+    mainOled->clearDisplay();
+    mainOled->setTextColor(SSD1306_WHITE);
+    mainOled->setTextWrap(false);
+    mainOled->setTextSize(1);
+
+    char line[24];
+
+    mainOled->setCursor(3, 0);
+    mainOled->print("TRIP");
+    mainOled->drawLine(0, 9, 128, 9, SSD1306_WHITE);
+
+    snprintf(line, sizeof(line), "Avg   %3u km/h", avgKph);
+    mainOled->setCursor(3, 13);
+    mainOled->print(line);
+
+    snprintf(line, sizeof(line), "Max   %3u km/h", maxKph);
+    mainOled->setCursor(3, 23);
+    mainOled->print(line);
+
+    snprintf(line, sizeof(line), "RPM   %4u", maxRpm);
+    mainOled->setCursor(3, 33);
+    mainOled->print(line);
+
+    snprintf(line, sizeof(line), "Temp  %3d C", maxCoolantC);
+    mainOled->setCursor(3, 43);
+    mainOled->print(line);
+
+    snprintf(line, sizeof(line), "Drive %lum Idle %lum", movingMin, idleMin);
+    mainOled->setCursor(3, 55);
+    mainOled->print(line);
+
+    mainOled->displayChanged();
+}
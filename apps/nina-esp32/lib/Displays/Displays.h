@@ -11,13 +11,52 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include <Adafruit_SSD1306.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include "PartialSSD1306.h"
 
 class Displays {
 public:
+    // Main OLED page
+    enum class Screen : uint8_t {
+        Odometer,
+        Trip
+    };
+
+    struct TripPage {
+        uint16_t avgKph;
+        uint16_t maxKph;
+        uint16_t maxRpm;
+        int16_t maxCoolantC;
+        uint32_t movingMin;
+        uint32_t idleMin;
+    };
+
+    // Everything one frame needs, copied by value into the mailbox
+    struct Snapshot {
+        Screen screen;
+        uint8_t fuelPct;
+        uint8_t tempPct;
+        uint8_t contrast;
+        uint32_t odometerKm;
+        uint32_t tripKm;
+        TripPage trip; // Screen::Trip only
+    };
+
+    // posted - rendered = snapshots replaced before the task got to them
+    // (plus the one waiting). Times cover render + I2C flush.
+    struct RenderStats {
+        uint32_t posted;
+        uint32_t rendered;
+        uint32_t lastUs;
+        uint32_t maxUs;
+    };
+
     Displays(
-      Adafruit_SSD1306& fuelDisplay,
-      Adafruit_SSD1306& tempDisplay,
-      Adafruit_SSD1306* mainOledDisplayPtr  // 128x64 SSD1309 OLED (replaces LCD)
+      PartialSSD1306& fuelDisplay,
+      PartialSSD1306& tempDisplay,
+      PartialSSD1306* mainOledDisplayPtr  // 128x64 SSD1309 OLED (replaces LCD)
     );
 
     void begin(bool mainOledAvailable = true, bool fuelOledAvailable = true, bool tempOledAvailable = true);
@@ -34,19 +73,62 @@ public:
     // Main display - shows time, date, trip, and odometer
     void showOdometer(uint32_t km, uint32_t tripKm = 0);
 
+    // Main display - trip computer page (averages and maxima)
+    void showTrip(
+      uint16_t avgKph,
+      uint16_t maxKph,
+      uint16_t maxRpm,
+      int16_t maxCoolantC,
+      uint32_t movingMin,
+      uint32_t idleMin);
+
+    // SSD1306 contrast for all connected OLEDs (sent only on change)
+    void setContrast(uint8_t contrast);
+
+    // Render on a task pinned to `core`, at most one frame per minFrameMs.
+    // Call after begin(); from then on only post() may touch the OLEDs.
+    bool startTask(BaseType_t core, UBaseType_t priority, uint32_t minFrameMs,
+                   uint32_t stackBytes = 4096);
+
+    // Never blocks: replaces any snapshot the task hasn't picked up yet.
+    // Without a task the frame is rendered inline.
+    void post(const Snapshot& snapshot);
+
+    // Draw and flush every OLED from one snapshot (caller's context)
+    void render(const Snapshot& snapshot);
+
+    const RenderStats& renderStats() const { return renderStat; }
+
     bool isMainOledConnected() const { return mainOledConnected; }
     bool isFuelOledConnected() const { return fuelOledConnected; }
     bool isTempOledConnected() const { return tempOledConnected; }
 
 private:
-    void drawBar(Adafruit_SSD1306& disp, uint8_t pct);
+    void drawBar(PartialSSD1306& disp, uint8_t pct);
+
+    static void taskEntry(void* arg);
+    void runTask();
+
+    // Length-1 queue + xQueueOverwrite = latest-value mailbox
+    QueueHandle_t mailbox = nullptr;
+    TaskHandle_t task = nullptr;
+    TickType_t frameTicks = 0;
+
+    // posted is written by the poster, the rest by the renderer
+    RenderStats renderStat = {};
+
+    // Only changed pages/columns go over I2C (see PartialSSD1306)
+    PartialSSD1306& fuel;
+    PartialSSD1306& temp;
+    PartialSSD1306* mainOled;  // 128x64 main display
 
-    Adafruit_SSD1306& fuel;
-    Adafruit_SSD1306& temp;
-    Adafruit_SSD1306* mainOled;  // 128x64 main display
+    // Last drawn bar value; redraw only on change
+    int16_t fuelShown = -1;
+    int16_t tempShown = -1;
     bool mainOledConnected = false;
     bool fuelOledConnected = false;
     bool tempOledConnected = false;
+    int16_t contrast = -1;
 };
 
 #endif //NINA_DISPLAYS_H
\ No newline at end of file
@@ -0,0 +1,141 @@
+//
+// SSD1306 with dirty-window transfers
+//
+
+#include "PartialSSD1306.h"
+
+PartialSSD1306::PartialSSD1306(uint8_t w, uint8_t h, TwoWire* twi, int8_t rstPin)
+  : Adafruit_SSD1306(w, h, twi, rstPin) {}
+
+PartialSSD1306::~PartialSSD1306() {
+    free(shadow);
+}
+
+void PartialSSD1306::setBus(I2CBus& b, int8_t device) {
+    if (device < 0) return;
+    bus = &b;
+    busDevice = device;
+}
+
+void PartialSSD1306::command(const uint8_t* cmds, uint8_t n) {
+    if (bus) {
+        bus->write(busDevice, cmds, n, I2CBus::NORMAL, 0x00); // Co = 0, D/C = 0
+        return;
+    }
+    ssd1306_commandList(cmds, n);
+}
+
+bool PartialSSD1306::ensureShadow() {
+    if (!shadow)
+        shadow = static_cast<uint8_t*>(malloc(WIDTH * pages()));
+    return shadow != nullptr;
+}
+
+// Address + control byte + data, per chunk
+uint32_t PartialSSD1306::windowBytes(uint16_t columns) const {
+    uint32_t chunks = (columns + dataChunk() - 1) / dataChunk();
+    return 2 + WINDOW_CMD_BYTES + chunks * 2 + columns;
+}
+
+uint32_t PartialSSD1306::fullFrameBytes() const {
+    // display(): page + column window, then the whole buffer
+    uint32_t data = WIDTH * pages();
+    uint32_t chunks = (data + dataChunk() - 1) / dataChunk();
+    return 2 + WINDOW_CMD_BYTES + chunks * 2 + data;
+}
+
+void PartialSSD1306::sendFrame() {
+    const uint8_t window[WINDOW_CMD_BYTES] = {
+        SSD1306_PAGEADDR, 0, static_cast<uint8_t>(pages() - 1),
+        SSD1306_COLUMNADDR, 0, static_cast<uint8_t>(WIDTH - 1)};
+    command(window, sizeof(window));
+    bus->write(busDevice, buffer, WIDTH * pages(), I2CBus::BULK, 0x40);
+}
+
+void PartialSSD1306::displayAll() {
+    if (bus && buffer)
+        sendFrame();
+    else
+        display();
+
+    transfer.lastFrameBytes = fullFrameBytes();
+    transfer.totalBytes += transfer.lastFrameBytes;
+    transfer.frames++;
+
+    if (ensureShadow()) {
+        memcpy(shadow, buffer, WIDTH * pages());
+        synced = true;
+    }
+}
+
+void PartialSSD1306::displayChanged() {
+    if (!wire || !buffer || !synced || !ensureShadow()) {
+        displayAll(); // SPI, first frame, or no memory for the shadow
+        return;
+    }
+
+    uint32_t sent = 0;
+
+#if ARDUINO >= 157
+    if (!bus) wire->setClock(wireClk);
+#endif
+
+    for (uint8_t p = 0; p < pages(); p++) {
+        const uint8_t* row = buffer + p * WIDTH;
+        uint8_t* seen = shadow + p * WIDTH;
+
+        int16_t c0 = 0;
+        while (c0 < WIDTH && row[c0] == seen[c0])
+            c0++;
+        if (c0 == WIDTH)
+            continue; // page unchanged
+
+        int16_t c1 = WIDTH - 1;
+        while (row[c1] == seen[c1])
+            c1--;
+
+        sent += windowBytes(c1 - c0 + 1);
+        if (sendWindow(p, c0, c1))
+            memcpy(seen + c0, row + c0, c1 - c0 + 1);
+        else
+            synced = false; // panel state unknown – next frame goes out whole
+    }
+
+#if ARDUINO >= 157
+    if (!bus) wire->setClock(restoreClk);
+#endif
+
+    transfer.lastFrameBytes = sent;
+    transfer.totalBytes += sent;
+    transfer.frames++;
+    if (sent == 0)
+        transfer.skippedFrames++;
+}
+
+bool PartialSSD1306::sendWindow(uint8_t page, uint8_t c0, uint8_t c1) {
+    const uint8_t window[WINDOW_CMD_BYTES] = {
+        SSD1306_COLUMNADDR, c0, c1,
+        SSD1306_PAGEADDR, page, page};
+    command(window, sizeof(window));
+
+    // Horizontal addressing: data fills the window left to right
+    const uint8_t* ptr = buffer + page * WIDTH + c0;
+    uint16_t count = c1 - c0 + 1;
+
+    if (bus)
+        return bus->write(busDevice, ptr, count, I2CBus::BULK, 0x40) == 0; // chunked by the bus
+
+    bool ok = true;
+    while (count) {
+        uint16_t n = count > DATA_CHUNK ? DATA_CHUNK : count;
+
+        wire->beginTransmission(i2caddr);
+        wire->write(static_cast<uint8_t>(0x40)); // Co = 0, D/C = 1
+        wire->write(ptr, n);
+        ok &= wire->endTransmission() == 0;
+
+        ptr += n;
+        count -= n;
+    }
+    return ok;
+}
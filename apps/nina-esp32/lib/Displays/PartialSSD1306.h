@@ -0,0 +1,77 @@
+//
+// SSD1306 with dirty-window transfers
+//
+
+#ifndef NINA_PARTIALSSD1306_H
+#define NINA_PARTIALSSD1306_H
+
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Adafruit_SSD1306.h>
+#include <I2CBus.h>
+
+// Keeps a copy of what the panel actually shows. displayChanged() diffs
+// the framebuffer against it page by page (8-pixel rows) and sends only
+// the changed column span of each page through a COLUMNADDR/PAGEADDR
+// window; an unchanged frame costs no bus traffic at all.
+// Drawing is untouched – it is still the Adafruit_GFX buffer.
+class PartialSSD1306 : public Adafruit_SSD1306 {
+public:
+    struct TransferStats {
+        uint32_t lastFrameBytes; // on the wire, incl. address + control bytes
+        uint32_t totalBytes;
+        uint32_t frames;         // displayChanged() calls
+        uint32_t skippedFrames;  // nothing changed
+    };
+
+    PartialSSD1306(uint8_t w, uint8_t h, TwoWire* twi, int8_t rstPin = -1);
+    ~PartialSSD1306();
+
+    // Queue transfers on a scheduled bus (after begin()): framebuffer data
+    // goes as BULK chunks, commands as NORMAL. The bus owns the clock.
+    void setBus(I2CBus& bus, int8_t device);
+
+    // Command list through the bus if there is one
+    void command(const uint8_t* cmds, uint8_t n);
+
+    // Send only what differs from the panel
+    void displayChanged();
+
+    // Full transfer (base display()), then track from there
+    void displayAll();
+
+    // Forget the panel contents – the next displayChanged() sends all
+    void invalidate() { synced = false; }
+
+    const TransferStats& stats() const { return transfer; }
+
+    // What a full display() costs, for comparison with lastFrameBytes
+    uint32_t fullFrameBytes() const;
+
+private:
+    // Data bytes per I2C transaction (Wire buffer minus the control byte)
+#ifdef I2C_BUFFER_LENGTH
+    static constexpr uint16_t DATA_CHUNK = I2C_BUFFER_LENGTH - 1;
+#else
+    static constexpr uint16_t DATA_CHUNK = 31;
+#endif
+    static constexpr uint8_t WINDOW_CMD_BYTES = 6;
+
+    uint8_t pages() const { return (HEIGHT + 7) / 8; }
+    uint16_t dataChunk() const { return bus ? bus->chunkBytes() : DATA_CHUNK; }
+    uint32_t windowBytes(uint16_t columns) const;
+    bool ensureShadow();
+    bool sendWindow(uint8_t page, uint8_t c0, uint8_t c1);
+    void sendFrame();
+
+    I2CBus* bus = nullptr;
+    int8_t busDevice = -1;
+
+    uint8_t* shadow = nullptr;
+    bool synced = false;
+    TransferStats transfer{};
+};
+
+#endif //NINA_PARTIALSSD1306_H
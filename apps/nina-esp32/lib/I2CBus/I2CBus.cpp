@@ -0,0 +1,247 @@
+#include "I2CBus.h"
+
+I2CBus::I2CBus(TwoWire &w, uint16_t chunkBytes)
+    : wire(w), chunk(chunkBytes)
+{
+#ifdef I2C_BUFFER_LENGTH
+    if (chunk > I2C_BUFFER_LENGTH - 1)
+        chunk = I2C_BUFFER_LENGTH - 1; // prefix byte + chunk per transaction
+#endif
+    if (chunk == 0)
+        chunk = 1;
+}
+
+int8_t I2CBus::addDevice(uint8_t address, uint32_t maxHz)
+{
+    if (task || devCount >= MAX_DEVICES)
+        return -1;
+
+    Device &d = devices[devCount];
+    d.address = address;
+    d.maxHz = maxHz;
+    return devCount++;
+}
+
+bool I2CBus::begin(BaseType_t core, UBaseType_t priority, uint32_t stackBytes)
+{
+    if (task)
+        return true;
+    if (devCount == 0)
+        return false; // nothing to schedule, clock untouched
+
+    // Slowest device sets the pace
+    busHz = 0;
+    for (uint8_t i = 0; i < devCount; i++)
+    {
+        if (busHz == 0 || devices[i].maxHz < busHz)
+            busHz = devices[i].maxHz;
+    }
+    wire.setClock(busHz);
+
+    for (uint8_t p = 0; p < PRIORITY_COUNT; p++)
+    {
+        queues[p] = xQueueCreate(QUEUE_DEPTH, sizeof(Request *));
+        if (!queues[p])
+            return false; // stays inline
+    }
+
+    if (xTaskCreatePinnedToCore(taskEntry, "i2cbus", stackBytes, this, priority, &task, core) != pdPASS)
+    {
+        task = nullptr;
+        return false;
+    }
+    return true;
+}
+
+// -------------------------------------------------
+// Caller side
+// -------------------------------------------------
+
+uint8_t I2CBus::write(int8_t device, const uint8_t *data, size_t len, Priority priority, int16_t prefix)
+{
+    Request r = {};
+    r.device = device;
+    r.prefix = prefix;
+    r.tx = data;
+    r.txLen = len;
+    return submit(r, priority);
+}
+
+uint8_t I2CBus::read(int8_t device, uint8_t *data, size_t len, Priority priority)
+{
+    Request r = {};
+    r.device = device;
+    r.prefix = -1;
+    r.rx = data;
+    r.rxLen = len;
+    return submit(r, priority);
+}
+
+uint8_t I2CBus::writeRead(int8_t device, const uint8_t *tx, size_t txLen, uint8_t *rx, size_t rxLen, Priority priority)
+{
+    Request r = {};
+    r.device = device;
+    r.prefix = -1;
+    r.tx = tx;
+    r.txLen = txLen;
+    r.rx = rx;
+    r.rxLen = rxLen;
+    return submit(r, priority);
+}
+
+uint8_t I2CBus::submit(Request &r, Priority priority)
+{
+    if (r.device < 0 || r.device >= devCount || priority >= PRIORITY_COUNT)
+        return 4;
+
+    r.queuedUs = micros();
+
+    if (!task)
+    {
+        run(r);
+        return r.status;
+    }
+
+    r.waiter = xTaskGetCurrentTaskHandle();
+    Request *p = &r;
+    xQueueSend(queues[priority], &p, portMAX_DELAY);
+    xTaskNotifyGive(task);
+
+    // r stays on this stack until the owner is done with it
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    return r.status;
+}
+
+void I2CBus::run(Request &r)
+{
+    while (!step(r))
+    {
+    }
+    finish(r);
+}
+
+// -------------------------------------------------
+// Owner side
+// -------------------------------------------------
+
+void I2CBus::taskEntry(void *arg)
+{
+    static_cast<I2CBus *>(arg)->runTask();
+}
+
+void I2CBus::runTask()
+{
+    for (;;)
+    {
+        // Highest priority with work; a split write keeps its slot and
+        // resumes once nothing above it is waiting
+        int8_t p = -1;
+        for (uint8_t i = 0; i < PRIORITY_COUNT; i++)
+        {
+            if (!active[i])
+                xQueueReceive(queues[i], &active[i], 0);
+            if (active[i])
+            {
+                p = i;
+                break;
+            }
+        }
+
+        if (p < 0)
+        {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+
+        Request &r = *active[p];
+
+        if (p == URGENT && !r.started)
+        {
+            for (uint8_t i = p + 1; i < PRIORITY_COUNT; i++)
+            {
+                if (active[i] && active[i]->started)
+                {
+                    preemptCount++;
+                    break;
+                }
+            }
+        }
+
+        if (step(r))
+        {
+            active[p] = nullptr;
+            finish(r);
+        }
+    }
+}
+
+bool I2CBus::step(Request &r)
+{
+    Device &d = devices[r.device];
+
+    if (!r.started)
+    {
+        r.started = true;
+        r.startUs = micros();
+
+        uint32_t waitUs = r.startUs - r.queuedUs;
+        if (waitUs > d.stats.maxWaitUs)
+            d.stats.maxWaitUs = waitUs;
+    }
+
+    // Write part (also a bare address probe when there is nothing to read)
+    if (r.sent < r.txLen || r.rxLen == 0)
+    {
+        size_t n = r.txLen - r.sent;
+        if (r.prefix >= 0 && n > chunk)
+            n = chunk;
+        bool last = r.sent + n == r.txLen;
+
+        wire.beginTransmission(d.address);
+        if (r.prefix >= 0)
+            wire.write(static_cast<uint8_t>(r.prefix));
+        if (n)
+            wire.write(r.tx + r.sent, n);
+
+        // Repeated start into the read
+        uint8_t err = wire.endTransmission(!(last && r.rxLen));
+
+        d.stats.bytes += 1 + (r.prefix >= 0) + n;
+        r.sent += n;
+
+        if (err)
+        {
+            r.status = err;
+            return true;
+        }
+        if (!last)
+            return false;
+        if (r.rxLen == 0)
+            return true;
+    }
+
+    uint8_t got = wire.requestFrom(d.address, static_cast<uint8_t>(r.rxLen));
+    for (uint8_t i = 0; i < got; i++)
+        r.rx[i] = wire.read();
+
+    d.stats.bytes += 1 + got;
+    if (got != r.rxLen)
+        r.status = 4;
+    return true;
+}
+
+void I2CBus::finish(Request &r)
+{
+    DeviceStats &s = devices[r.device].stats;
+
+    uint32_t us = micros() - r.queuedUs;
+    s.lastUs = us;
+    if (us > s.maxUs)
+        s.maxUs = us;
+    s.transactions++;
+    if (r.status)
+        s.errors++;
+
+    if (r.waiter)
+        xTaskNotifyGive(r.waiter);
+}
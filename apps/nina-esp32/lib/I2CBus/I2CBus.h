@@ -0,0 +1,130 @@
+#ifndef NINA_I2CBUS_H
+#define NINA_I2CBUS_H
+
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+
+// One owner task per TwoWire. Callers queue transactions by priority and
+// block until theirs is done; the owner runs them one step at a time and
+// re-checks the queues between steps, so a short URGENT read waits for at
+// most one chunk of a framebuffer write, never the whole frame.
+//
+// Long writes are split into chunks that each repeat the prefix byte
+// (SSD1306: 0x40 = "data follows"), so every chunk is a complete
+// transaction and the device doesn't care what runs in between.
+//
+// The bus clock is the slowest device's limit: Fast-mode Plus (1 MHz)
+// only when everything on the wire allows it.
+//
+// Until begin() starts the owner task, transactions run inline in the
+// caller (setup, or a failed task).
+class I2CBus
+{
+public:
+    enum Priority : uint8_t
+    {
+        URGENT, // short polls (input nodes)
+        NORMAL, // commands
+        BULK,   // framebuffers
+        PRIORITY_COUNT
+    };
+
+    static constexpr uint8_t MAX_DEVICES = 4;
+
+    struct DeviceStats
+    {
+        uint32_t transactions;
+        uint32_t bytes;     // on the wire, incl. address + prefix bytes
+        uint32_t errors;
+        uint32_t lastUs;    // queued → done
+        uint32_t maxUs;
+        uint32_t maxWaitUs; // queued → first byte (head-of-line blocking)
+    };
+
+    // chunkBytes: data bytes per transaction for split writes; bounds how
+    // long an URGENT request can be held up (32 B ≈ 0.3 ms at 1 MHz)
+    I2CBus(TwoWire &wire, uint16_t chunkBytes = 32);
+
+    // Returns a device handle or -1. Call before begin().
+    int8_t addDevice(uint8_t address, uint32_t maxHz);
+
+    // Sets the clock and starts the owner task (false without devices)
+    bool begin(BaseType_t core, UBaseType_t priority, uint32_t stackBytes = 3072);
+
+    // Blocking, task context. Return 0 or a Wire error code
+    // (endTransmission() codes, 4 for a short read).
+    // prefix >= 0 is sent before every chunk; without one the write must
+    // fit a single transaction (the Wire buffer).
+    uint8_t write(int8_t device, const uint8_t *data, size_t len, Priority priority, int16_t prefix = -1);
+    uint8_t read(int8_t device, uint8_t *data, size_t len, Priority priority);
+    uint8_t writeRead(int8_t device, const uint8_t *tx, size_t txLen, uint8_t *rx, size_t rxLen, Priority priority);
+
+    uint32_t clockHz() const { return busHz; }
+    uint16_t chunkBytes() const { return chunk; }
+    uint8_t deviceCount() const { return devCount; }
+    uint8_t address(int8_t device) const { return devices[device].address; }
+    const DeviceStats &stats(int8_t device) const { return devices[device].stats; }
+
+    // Times an URGENT request was served in the middle of a split write
+    uint32_t preemptions() const { return preemptCount; }
+
+private:
+    static constexpr uint8_t QUEUE_DEPTH = 4; // per priority
+
+    struct Device
+    {
+        uint8_t address;
+        uint32_t maxHz;
+        DeviceStats stats;
+    };
+
+    // Lives on the caller's stack while it waits
+    struct Request
+    {
+        int8_t device;
+        int16_t prefix;
+        const uint8_t *tx;
+        size_t txLen;
+        uint8_t *rx;
+        size_t rxLen;
+
+        size_t sent;
+        bool started;
+        uint32_t queuedUs;
+        uint32_t startUs;
+
+        TaskHandle_t waiter;
+        uint8_t status;
+    };
+
+    uint8_t submit(Request &r, Priority priority);
+    void run(Request &r);
+
+    // One transaction: a chunk of the write, or the (last write +) read.
+    // Returns true when the request is finished.
+    bool step(Request &r);
+    void finish(Request &r);
+
+    static void taskEntry(void *arg);
+    void runTask();
+
+    TwoWire &wire;
+    uint16_t chunk;
+    uint32_t busHz = 0;
+
+    Device devices[MAX_DEVICES]{};
+    uint8_t devCount = 0;
+
+    QueueHandle_t queues[PRIORITY_COUNT]{};
+    Request *active[PRIORITY_COUNT]{};
+    TaskHandle_t task = nullptr;
+
+    uint32_t preemptCount = 0;
+};
+
+#endif // NINA_I2CBUS_H
@@ -5,11 +5,20 @@
 
 #include <Arduino.h>
 #include <Ticker.h>
+#include <atomic>
+#include <esp_timer.h>
+#include "MultiplexTransport.h"
+#include "MuxPattern.h"
 
-template <uint8_t NUM_REGS>
+template <uint8_t NUM_REGS, uint8_t MAX_CHANNELS = 4, uint8_t BCM_BITS = 3>
 class Multiplex
 {
+    static_assert(BCM_BITS >= 1 && BCM_BITS <= 7, "BCM_BITS out of range");
+
 public:
+    static constexpr uint8_t OUTPUTS = NUM_REGS * 8;
+    static constexpr uint8_t MAX_LEVEL = (1 << BCM_BITS) - 1;
+
     using RenderFn = void (*)(uint8_t channel, void *ctx, uint8_t *regs);
 
     Multiplex(
@@ -17,33 +26,51 @@ public:
         uint8_t clockPin,
         uint8_t latchPin,
         uint8_t channels,
-        uint32_t refreshMs)
-        : dataPin(dataPin),
-          clockPin(clockPin),
-          latchPin(latchPin),
-          channels(channels),
-          refreshMs(refreshMs)
+        uint32_t refreshUs)
+        : bitBang(dataPin, clockPin, latchPin),
+          channels(channels > MAX_CHANNELS ? MAX_CHANNELS : channels),
+          refreshUs(refreshUs)
+    {
+        memset(levels, MAX_LEVEL, sizeof(levels));
+        memset(patterns, 0, sizeof(patterns));
+    }
+
+    // Swap the default bit-bang path for another backend (call before begin)
+    void setTransport(MultiplexTransport &t)
     {
+        transport = &t;
     }
 
     void begin()
     {
-        pinMode(dataPin, OUTPUT);
-        pinMode(clockPin, OUTPUT);
-        pinMode(latchPin, OUTPUT);
+        transport->begin();
         clear();
         flush();
     }
 
-    void start()
+    // Ticker fallback – a no-op once MuxScheduler owns this instance.
+    // Ticker runs on whole ms, so refreshUs rounds down to a multiple of
+    // 1000. Shorter periods are refused (returns false): the LSB plane
+    // can't get shorter than one tick, so a 250 µs chain on 1 ms ticks
+    // would stretch a 3-digit BCM cycle to 21 ms and flicker.
+    bool start()
     {
+        if (scheduled)
+            return true;
+        if (refreshUs < 1000)
+            return false;
+
+        uint32_t ms = refreshUs / 1000;
+        tickUs = ms * 1000; // keep pattern timing honest
+
         ticker.attach_ms(
-            refreshMs,
+            ms,
             +[](Multiplex *self)
             {
-                self->onTick();
+                self->tick();
             },
             this);
+        return true;
     }
 
     void stop()
@@ -51,6 +78,22 @@ public:
         ticker.detach();
     }
 
+    // --- scheduler hooks
+    void setScheduled(bool on)
+    {
+        scheduled = on;
+    }
+
+    bool isrSafe() const
+    {
+        return transport->isrSafe();
+    }
+
+    uint32_t refreshPeriodUs() const
+    {
+        return refreshUs;
+    }
+
     // 🔥 BACKWARD COMPATIBLE
     void setRenderer(void (*fn)(uint8_t, void *), void *userCtx)
     {
@@ -65,6 +108,143 @@ public:
         ctx = userCtx;
     }
 
+    // --- frame cache (render-on-change)
+    // Producers write the on/off image of every channel they use into
+    // backFrame(), then publish(). publish() expands it into BCM bit-planes
+    // (image & per-output level & global brightness) once; tick() only
+    // copies prepared bytes out, and skips the shift when they match what
+    // is already latched.
+    // Triple-buffered: publish() never blocks and the ISR never sees a
+    // half-written frame. One producer only.
+    void enableFrameCache()
+    {
+        frameCache = true;
+    }
+
+    uint8_t *backFrame(uint8_t channel)
+    {
+        return image[channel];
+    }
+
+    void publish()
+    {
+        buildFrame(frames[backIdx]);
+
+        uint32_t prev = pending.exchange(backIdx | FRAME_FRESH, std::memory_order_acq_rel);
+        backIdx = prev & FRAME_INDEX;
+    }
+
+    // --- brightness (binary code modulation)
+    // Plane k is shown for 2^k ticks, so one channel takes MAX_LEVEL ticks.
+    // Keep refreshUs × MAX_LEVEL × channels well under ~10 ms.
+    void setBrightness(uint8_t level)
+    {
+        if (level > MAX_LEVEL)
+            level = MAX_LEVEL;
+        if (level == brightness)
+            return;
+
+        brightness = level;
+        if (frameCache)
+            publish();
+    }
+
+    uint8_t getBrightness() const
+    {
+        return brightness;
+    }
+
+    // output = reg * 8 + bit; takes effect on the next publish()
+    void setOutputLevel(uint8_t channel, uint8_t output, uint8_t level)
+    {
+        if (channel >= MAX_CHANNELS || output >= OUTPUTS)
+            return;
+
+        levels[channel][output] = level > MAX_LEVEL ? MAX_LEVEL : level;
+    }
+
+    // --- pattern sequencer
+    // Assign a blink pattern to one output (reg * 8 + bit) or a whole
+    // channel; takes effect on the next publish(). The ISR advances the
+    // pattern every MUX_PATTERN_STEP_US, independent of loop() load.
+    void setPattern(uint8_t channel, uint8_t output, MuxPattern pattern)
+    {
+        if (channel >= MAX_CHANNELS || output >= OUTPUTS)
+            return;
+
+        patterns[channel][output] = static_cast<uint8_t>(pattern);
+    }
+
+    void setChannelPattern(uint8_t channel, MuxPattern pattern)
+    {
+        for (uint8_t o = 0; o < OUTPUTS; o++)
+        {
+            setPattern(channel, o, pattern);
+        }
+    }
+
+    // --- live gates (frame cache only)
+    // Gate outputs of the published frame off or back on from any
+    // context, ISRs included, without publish(). The owner draws live
+    // outputs as on in its image; the next tick() re-shows the current
+    // plane, so a change is latched within one refresh period (on a
+    // multi-channel chain: when its channel is next shown).
+    // Registers 0–3 only. stampUs (micros() of the cause, 0 = none) feeds
+    // liveLatency() of each source in `sources` (bit = source, caller's
+    // numbering, e.g. one per light).
+    static constexpr uint8_t LIVE_SOURCES = 8;
+
+    void IRAM_ATTR setLive(uint8_t channel, uint8_t reg, uint8_t onBits, uint8_t mask,
+                           uint32_t stampUs = 0, uint8_t sources = 1)
+    {
+        if (channel >= MAX_CHANNELS || reg >= 4)
+            return;
+
+        uint32_t shift = reg * 8;
+        uint32_t clear = static_cast<uint32_t>(mask) << shift;
+        uint32_t set = static_cast<uint32_t>(mask & ~onBits) << shift;
+
+        uint32_t cur = liveOff[channel].load(std::memory_order_relaxed);
+        while (!liveOff[channel].compare_exchange_weak(
+            cur, (cur & ~clear) | set, std::memory_order_acq_rel))
+        {
+        }
+
+        if (stampUs && sources)
+        {
+            for (uint8_t s = 0; s < LIVE_SOURCES; s++)
+            {
+                if (sources & (1 << s))
+                    liveStampUs[s].store(stampUs, std::memory_order_relaxed);
+            }
+            liveStamped.fetch_or(sources, std::memory_order_release);
+        }
+        liveDirty.store(1, std::memory_order_release);
+    }
+
+    // Cause → latched, measured by the refresh ISR
+    struct LiveLatency
+    {
+        uint32_t lastUs;
+        uint32_t maxUs;
+        uint32_t meanUs;
+        uint32_t samples;
+    };
+
+    LiveLatency liveLatency(uint8_t source = 0) const
+    {
+        LiveLatency l{};
+        if (source >= LIVE_SOURCES)
+            return l;
+
+        const LatencyStats &s = latency[source];
+        l.lastUs = s.lastUs;
+        l.maxUs = s.maxUs;
+        l.samples = s.samples;
+        l.meanUs = s.samples ? static_cast<uint32_t>(s.sumUs / s.samples) : 0;
+        return l;
+    }
+
     // --- register helpers
     void clear()
     {
@@ -76,20 +256,37 @@ public:
         return regs;
     }
 
-    void flush()
+    void IRAM_ATTR flush()
     {
-        digitalWrite(latchPin, LOW);
-        for (int i = NUM_REGS - 1; i >= 0; i--)
-        {
-            shiftOut(dataPin, clockPin, MSBFIRST, regs[i]);
-        }
-
-        digitalWrite(latchPin, HIGH);
+        transport->send(regs, NUM_REGS);
     }
 
-private:
-    void IRAM_ATTR onTick()
+    // One refresh step (Ticker callback or MuxScheduler ISR)
+    void IRAM_ATTR tick()
     {
+        if (frameCache)
+        {
+            if (liveDirty.exchange(0, std::memory_order_acquire))
+                showLive();
+
+            patternUs += tickUs;
+            if (patternUs >= MUX_PATTERN_STEP_US)
+            {
+                patternUs -= MUX_PATTERN_STEP_US;
+                patternStep = (patternStep + 1) & 31;
+
+                // Blink edge mid-plane: re-output the current plane now
+                if (updateBlink() && planeTicks != 0)
+                    showPlane();
+            }
+
+            if (planeTicks == 0)
+                nextPlane();
+
+            planeTicks--;
+            return;
+        }
+
         clear();
 
         if (renderer)
@@ -108,9 +305,194 @@ private:
             currentChannel = 0;
     }
 
-    uint8_t dataPin, clockPin, latchPin;
+private:
+    static constexpr uint32_t FRAME_INDEX = 0x03;
+    static constexpr uint32_t FRAME_FRESH = 0x04;
+
+    // Everything the ISR needs, prepared by publish()
+    struct Frame
+    {
+        uint8_t planes[MAX_CHANNELS][BCM_BITS][NUM_REGS];
+        uint8_t blink[MUX_PATTERN_COUNT][MAX_CHANNELS][NUM_REGS]; // outputs per pattern
+        uint8_t patternsUsed;                                     // bit p = pattern p present
+    };
+
+    void buildFrame(Frame &out) const
+    {
+        memset(&out, 0, sizeof(out));
+
+        for (uint8_t ch = 0; ch < channels; ch++)
+        {
+            for (uint8_t o = 0; o < OUTPUTS; o++)
+            {
+                uint8_t reg = o / 8;
+                uint8_t mask = 1 << (o % 8);
+
+                uint8_t p = patterns[ch][o];
+                if (p != 0 && p < MUX_PATTERN_COUNT)
+                {
+                    out.blink[p][ch][reg] |= mask;
+                    out.patternsUsed |= 1 << p;
+                }
+
+                if (!(image[ch][reg] & mask))
+                    continue;
+
+                uint8_t level = (levels[ch][o] * brightness + MAX_LEVEL / 2) / MAX_LEVEL;
+                for (uint8_t k = 0; k < BCM_BITS; k++)
+                {
+                    if (level & (1 << k))
+                        out.planes[ch][k][reg] |= mask;
+                }
+            }
+        }
+    }
+
+    // Rebuild the "blinked off" masks for the current step.
+    // Returns true if they changed.
+    bool IRAM_ATTR updateBlink()
+    {
+        const Frame &f = frames[frontIdx];
+        bool changed = false;
+
+        for (uint8_t ch = 0; ch < channels; ch++)
+        {
+            for (uint8_t reg = 0; reg < NUM_REGS; reg++)
+            {
+                uint8_t off = 0;
+
+                if (f.patternsUsed)
+                {
+                    for (uint8_t p = 1; p < MUX_PATTERN_COUNT; p++)
+                    {
+                        if (!(muxPatternMask(p) & (1UL << patternStep)))
+                            off |= f.blink[p][ch][reg];
+                    }
+                }
+
+                if (off != blinkOff[ch][reg])
+                {
+                    blinkOff[ch][reg] = off;
+                    changed = true;
+                }
+            }
+        }
+
+        return changed;
+    }
+
+    // Advance to the next bit-plane (and channel); shift only on change
+    void IRAM_ATTR nextPlane()
+    {
+        if (++currentPlane >= BCM_BITS)
+        {
+            currentPlane = 0;
+            if (++currentChannel >= channels)
+                currentChannel = 0;
+
+            // Swap only at the start of a cycle so all digits show one frame
+            if (currentChannel == 0 && takeFrame())
+                updateBlink();
+        }
+
+        planeTicks = 1 << currentPlane;
+        showPlane();
+    }
+
+    // A live gate changed: re-show now and time it
+    void IRAM_ATTR showLive()
+    {
+        if (planeTicks != 0)
+            showPlane(); // else nextPlane() below shows it this tick
+
+        uint32_t stamped = liveStamped.exchange(0, std::memory_order_acquire);
+        if (!stamped)
+            return;
+
+        // micros() may live in flash; the esp_timer clock is the same one
+        uint32_t now = static_cast<uint32_t>(esp_timer_get_time());
+        for (uint8_t s = 0; s < LIVE_SOURCES; s++)
+        {
+            if (!(stamped & (1 << s)))
+                continue;
+
+            LatencyStats &st = latency[s];
+            uint32_t us = now - liveStampUs[s].load(std::memory_order_relaxed);
+            st.lastUs = us;
+            if (us > st.maxUs)
+                st.maxUs = us;
+            st.sumUs += us;
+            st.samples++;
+        }
+    }
+
+    void IRAM_ATTR showPlane()
+    {
+        const uint8_t *plane = frames[frontIdx].planes[currentChannel][currentPlane];
+        const uint8_t *off = blinkOff[currentChannel];
+        uint32_t live = liveOff[currentChannel].load(std::memory_order_acquire);
+
+        uint8_t next[NUM_REGS];
+        for (uint8_t reg = 0; reg < NUM_REGS; reg++)
+        {
+            uint8_t gate = reg < 4 ? live >> (reg * 8) : 0;
+            next[reg] = plane[reg] & ~off[reg] & ~gate;
+        }
+
+        if (memcmp(regs, next, NUM_REGS) == 0)
+            return; // already latched
+
+        memcpy(regs, next, NUM_REGS);
+        flush();
+    }
+
+    bool IRAM_ATTR takeFrame()
+    {
+        if (!(pending.load(std::memory_order_acquire) & FRAME_FRESH))
+            return false;
+
+        uint32_t prev = pending.exchange(frontIdx, std::memory_order_acq_rel);
+        frontIdx = prev & FRAME_INDEX;
+        return true;
+    }
+
+    BitBangTransport bitBang;
+    MultiplexTransport *transport = &bitBang;
+
     uint8_t regs[NUM_REGS]{};
 
+    bool frameCache = false;
+    uint8_t image[MAX_CHANNELS][NUM_REGS]{};  // producer only
+    uint8_t levels[MAX_CHANNELS][OUTPUTS];    // producer only
+    uint8_t patterns[MAX_CHANNELS][OUTPUTS];  // producer only
+    uint8_t brightness = MAX_LEVEL;
+
+    Frame frames[3]{};
+    uint8_t backIdx = 0;                  // producer only
+    uint8_t frontIdx = 2;                 // ISR only
+    std::atomic<uint32_t> pending{1};     // middle buffer + fresh flag
+
+    uint8_t currentPlane = BCM_BITS - 1;  // ISR only
+    uint8_t planeTicks = 0;               // ISR only
+
+    uint8_t blinkOff[MAX_CHANNELS][NUM_REGS]{}; // ISR only
+    uint32_t patternUs = 0;                     // ISR only
+    uint8_t patternStep = 0;                    // ISR only
+
+    std::atomic<uint32_t> liveOff[MAX_CHANNELS]{}; // regs 0–3, bit set = gated off
+    std::atomic<uint32_t> liveDirty{0};
+    std::atomic<uint32_t> liveStamped{0};                // sources with a fresh stamp
+    std::atomic<uint32_t> liveStampUs[LIVE_SOURCES]{};
+
+    struct LatencyStats
+    {
+        volatile uint32_t lastUs;
+        volatile uint32_t maxUs;
+        volatile uint32_t samples;
+        uint64_t sumUs;
+    };
+    LatencyStats latency[LIVE_SOURCES]{}; // refresh ISR only
+
     Ticker ticker;
 
     RenderFn renderer = nullptr;
@@ -119,7 +501,9 @@ private:
 
     uint8_t currentChannel = 0;
     uint8_t channels;
-    uint32_t refreshMs;
+    uint32_t refreshUs;
+    uint32_t tickUs = refreshUs; // actual tick spacing (Ticker rounds to ms)
+    bool scheduled = false;
 };
 
 #endif // NINA_MULTIPLEX_H
@@ -0,0 +1,79 @@
+#ifndef NINA_MULTIPLEXTRANSPORT_H
+#define NINA_MULTIPLEXTRANSPORT_H
+
+#pragma once
+
+#include <Arduino.h>
+
+// Pushes one register image onto a 74HC595 chain and latches it.
+// regs[0] is the register nearest to the data input, so it is shifted
+// out LAST (same order as the original shiftOut() loop).
+class MultiplexTransport
+{
+public:
+    virtual ~MultiplexTransport() = default;
+
+    virtual void begin() = 0;
+    virtual void write(const uint8_t *regs, uint8_t numRegs) = 0;
+
+    // Safe to call send() from the IRAM timer ISR?
+    virtual bool isrSafe() const { return direct != nullptr; }
+
+    // What Multiplex calls. Vtables live in flash, which can't be read
+    // while a flash write/erase has the cache off, so ISR-safe transports
+    // register a direct (non-virtual) path; the rest go through write().
+    void IRAM_ATTR send(const uint8_t *regs, uint8_t numRegs)
+    {
+        if (direct)
+            direct(this, regs, numRegs);
+        else
+            write(regs, numRegs);
+    }
+
+protected:
+    using DirectFn = void (*)(MultiplexTransport *, const uint8_t *, uint8_t);
+
+    template <typename T>
+    static void IRAM_ATTR directWrite(MultiplexTransport *t, const uint8_t *regs, uint8_t numRegs)
+    {
+        static_cast<T *>(t)->T::write(regs, numRegs);
+    }
+
+    DirectFn direct = nullptr;
+};
+
+// Software fallback – shiftOut() + latch, exactly the old flush().
+// shiftOut()/digitalWrite() run from flash, so this stays on a Ticker.
+class BitBangTransport : public MultiplexTransport
+{
+public:
+    BitBangTransport(uint8_t dataPin, uint8_t clockPin, uint8_t latchPin)
+        : dataPin(dataPin),
+          clockPin(clockPin),
+          latchPin(latchPin)
+    {
+    }
+
+    void begin() override
+    {
+        pinMode(dataPin, OUTPUT);
+        pinMode(clockPin, OUTPUT);
+        pinMode(latchPin, OUTPUT);
+    }
+
+    void write(const uint8_t *regs, uint8_t numRegs) override
+    {
+        digitalWrite(latchPin, LOW);
+        for (int i = numRegs - 1; i >= 0; i--)
+        {
+            shiftOut(dataPin, clockPin, MSBFIRST, regs[i]);
+        }
+
+        digitalWrite(latchPin, HIGH);
+    }
+
+private:
+    uint8_t dataPin, clockPin, latchPin;
+};
+
+#endif // NINA_MULTIPLEXTRANSPORT_H
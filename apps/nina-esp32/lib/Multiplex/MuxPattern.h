@@ -0,0 +1,36 @@
+#ifndef NINA_MUXPATTERN_H
+#define NINA_MUXPATTERN_H
+
+#pragma once
+
+#include <Arduino.h>
+
+// Blink patterns advanced by the refresh ISR.
+// 32 steps of MUX_PATTERN_STEP_US = one 1 s loop; bit n set = output
+// visible during step n.
+enum class MuxPattern : uint8_t
+{
+    Steady = 0,
+    Flash2Hz,    // 250 ms on / 250 ms off
+    DoubleBlink, // two short blinks, then dark
+    Strobe       // 8 Hz – redline shift light
+};
+
+constexpr uint8_t MUX_PATTERN_COUNT = 4;
+constexpr uint32_t MUX_PATTERN_STEP_US = 31250;
+
+// In DRAM, not flash (nor a switch jump table): read by the refresh ISR
+// while flash writes/erases have the cache off
+static const uint32_t DRAM_ATTR MUX_PATTERN_MASKS[MUX_PATTERN_COUNT] = {
+    0xFFFFFFFF, // Steady
+    0x00FF00FF, // Flash2Hz
+    0x000001C7, // DoubleBlink
+    0x33333333, // Strobe
+};
+
+static inline uint32_t IRAM_ATTR muxPatternMask(uint8_t pattern)
+{
+    return pattern < MUX_PATTERN_COUNT ? MUX_PATTERN_MASKS[pattern] : 0xFFFFFFFF;
+}
+
+#endif // NINA_MUXPATTERN_H
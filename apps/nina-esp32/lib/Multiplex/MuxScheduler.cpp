@@ -0,0 +1,123 @@
+#include "MuxScheduler.h"
+
+MuxScheduler::MuxScheduler(uint8_t timerNum, uint32_t tickUs)
+    : group(static_cast<timer_group_t>(timerNum / 2)),
+      index(static_cast<timer_idx_t>(timerNum % 2)),
+      tickUs(tickUs)
+{
+}
+
+void MuxScheduler::begin()
+{
+    if (running || slotCount == 0)
+        return;
+
+    // 80 MHz APB / 80 → 1 µs per timer count
+    timer_config_t config = {};
+    config.alarm_en = TIMER_ALARM_EN;
+    config.counter_en = TIMER_PAUSE;
+    config.intr_type = TIMER_INTR_LEVEL;
+    config.counter_dir = TIMER_COUNT_UP;
+    config.auto_reload = TIMER_AUTORELOAD_EN;
+    config.divider = 80;
+
+    if (timer_init(group, index, &config) != ESP_OK)
+        return;
+
+    timer_set_counter_value(group, index, 0);
+    timer_set_alarm_value(group, index, tickUs);
+    timer_enable_intr(group, index);
+
+    // Not timerAttachInterrupt(): the Arduino HAL doesn't ask for an IRAM
+    // interrupt, so the ISR would be masked during every flash write
+    if (timer_isr_callback_add(group, index, &onTimer, this, ESP_INTR_FLAG_IRAM) != ESP_OK)
+    {
+        timer_deinit(group, index);
+        return;
+    }
+
+    timer_start(group, index);
+    running = true;
+}
+
+void MuxScheduler::stop()
+{
+    if (!running)
+        return;
+
+    timer_pause(group, index);
+    timer_disable_intr(group, index);
+    timer_isr_callback_remove(group, index);
+    timer_deinit(group, index);
+    running = false;
+}
+
+// Alarm flag clear and re-arm are done by the driver's IRAM dispatcher
+bool IRAM_ATTR MuxScheduler::onTimer(void *arg)
+{
+    MuxScheduler *self = static_cast<MuxScheduler *>(arg);
+    uint32_t now = ESP.getCycleCount();
+
+    if (self->resetPending)
+    {
+        self->minCycles = UINT32_MAX;
+        self->maxCycles = 0;
+        self->sumCycles = 0;
+        self->samples = 0;
+        self->resetPending = false;
+    }
+    else if (self->lastCycles != 0)
+    {
+        uint32_t interval = now - self->lastCycles;
+        if (interval < self->minCycles)
+            self->minCycles = interval;
+        if (interval > self->maxCycles)
+            self->maxCycles = interval;
+        self->sumCycles += interval;
+        self->samples++;
+    }
+    self->lastCycles = now;
+
+    for (uint8_t i = 0; i < self->slotCount; i++)
+    {
+        Slot &slot = self->slots[i];
+        if (--slot.countdown == 0)
+        {
+            slot.countdown = slot.periodTicks;
+            slot.fn(slot.obj);
+        }
+    }
+
+    return false; // nothing woken, no yield needed
+}
+
+// Diagnostic snapshot – may be one sample out of step with the ISR
+MuxScheduler::JitterStats MuxScheduler::jitter() const
+{
+    JitterStats stats{};
+    uint32_t n = samples;
+    if (n == 0)
+        return stats;
+
+    uint32_t cyclesPerUs = ESP.getCpuFreqMHz();
+    uint32_t minC = minCycles;
+    uint32_t maxC = maxCycles;
+    uint64_t sumC = sumCycles;
+
+    stats.minNs = static_cast<uint32_t>(minC * 1000ULL / cyclesPerUs);
+    stats.maxNs = static_cast<uint32_t>(maxC * 1000ULL / cyclesPerUs);
+    stats.meanNs = static_cast<uint32_t>(sumC * 1000ULL / cyclesPerUs / n);
+    stats.samples = n;
+
+    uint32_t tickNs = tickUs * 1000;
+    uint32_t early = tickNs > stats.minNs ? tickNs - stats.minNs : 0;
+    uint32_t late = stats.maxNs > tickNs ? stats.maxNs - tickNs : 0;
+    stats.worstDeviationNs = early > late ? early : late;
+
+    return stats;
+}
+
+void MuxScheduler::resetJitter()
+{
+    resetPending = true;
+}
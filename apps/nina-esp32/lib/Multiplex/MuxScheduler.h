@@ -0,0 +1,100 @@
+#ifndef NINA_MUXSCHEDULER_H
+#define NINA_MUXSCHEDULER_H
+
+#pragma once
+
+#include <Arduino.h>
+#include <driver/timer.h>
+#include "Multiplex.h"
+
+// One general-purpose hardware timer drives every registered Multiplex
+// from a single IRAM ISR. The interrupt is allocated ESP_INTR_FLAG_IRAM,
+// so refresh keeps running while a flash write/erase has the cache off;
+// everything it reaches (slots, Multiplex, transports, pattern table)
+// is in IRAM/DRAM. Each instance refreshes every
+// refreshPeriodUs() / tickUs base ticks; slot i fires on base-tick phase i,
+// so no two chains are shifted in the same tick as long as every period
+// is at least MAX_SLOTS ticks.
+class MuxScheduler
+{
+public:
+    static constexpr uint8_t MAX_SLOTS = 4;
+
+    // Base-tick interval as seen by the ISR (nanoseconds)
+    struct JitterStats
+    {
+        uint32_t minNs;
+        uint32_t maxNs;
+        uint32_t meanNs;
+        uint32_t worstDeviationNs; // max |interval - tickUs|
+        uint32_t samples;
+    };
+
+    MuxScheduler(uint8_t timerNum, uint32_t tickUs);
+
+    // timerNum 0–3: group timerNum / 2, index timerNum % 2
+    // Register before begin(). Takes a Multiplex or a ParallelShift group.
+    // Returns false (and leaves a Multiplex on its own Ticker) if the
+    // transport cannot run from an ISR.
+    template <typename Client>
+    bool add(Client &client)
+    {
+        if (running || slotCount >= MAX_SLOTS || !client.isrSafe())
+            return false;
+
+        uint32_t period = client.refreshPeriodUs() / tickUs;
+        if (period == 0)
+            period = 1;
+
+        Slot &slot = slots[slotCount];
+        slot.fn = &tickThunk<Client>;
+        slot.obj = &client;
+        slot.periodTicks = period;
+        slot.countdown = slotCount + 1; // phase stagger
+
+        slotCount++;
+        client.setScheduled(true);
+        return true;
+    }
+
+    void begin();
+    void stop();
+
+    JitterStats jitter() const;
+    void resetJitter();
+
+private:
+    struct Slot
+    {
+        void (*fn)(void *);
+        void *obj;
+        uint32_t periodTicks;
+        uint32_t countdown;
+    };
+
+    template <typename T>
+    static void IRAM_ATTR tickThunk(void *obj)
+    {
+        static_cast<T *>(obj)->tick();
+    }
+
+    static bool IRAM_ATTR onTimer(void *arg);
+
+    timer_group_t group;
+    timer_idx_t index;
+    uint32_t tickUs;
+    bool running = false;
+
+    Slot slots[MAX_SLOTS]{};
+    uint8_t slotCount = 0;
+
+    // --- jitter accounting (CPU cycles, written by the ISR only)
+    volatile uint32_t lastCycles = 0;
+    volatile uint32_t minCycles = UINT32_MAX;
+    volatile uint32_t maxCycles = 0;
+    volatile uint64_t sumCycles = 0;
+    volatile uint32_t samples = 0;
+    volatile bool resetPending = false;
+};
+
+#endif // NINA_MUXSCHEDULER_H
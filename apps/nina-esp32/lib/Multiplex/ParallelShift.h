@@ -0,0 +1,225 @@
+#ifndef NINA_PARALLELSHIFT_H
+#define NINA_PARALLELSHIFT_H
+
+#pragma once
+
+#include <Arduino.h>
+#include <soc/gpio_struct.h>
+#include "MultiplexTransport.h"
+
+// One 74HC595 chain with its pins fixed at compile time
+template <uint8_t DATA_PIN, uint8_t LATCH_PIN, uint8_t NUM_REGS>
+struct ShiftLane
+{
+    static_assert(DATA_PIN < 32 && LATCH_PIN < 32, "GPIO.out_w1ts/w1tc only cover GPIO0-31");
+
+    static constexpr uint8_t DATA = DATA_PIN;
+    static constexpr uint8_t LATCH = LATCH_PIN;
+    static constexpr uint8_t REGS = NUM_REGS;
+    static constexpr uint32_t DATA_MASK = 1UL << DATA_PIN;
+    static constexpr uint32_t LATCH_MASK = 1UL << LATCH_PIN;
+};
+
+constexpr uint8_t maxLaneRegs(uint8_t regs)
+{
+    return regs;
+}
+
+template <typename... Rest>
+constexpr uint8_t maxLaneRegs(uint8_t regs, Rest... rest)
+{
+    return regs > maxLaneRegs(rest...) ? regs : maxLaneRegs(rest...);
+}
+
+// Clocks every chain on a shared SRCLK at once: each clock edge carries one
+// bit to every lane through GPIO.out_w1ts/out_w1tc with masks folded at
+// compile time. Total shift time = longest chain, not the sum of chains.
+//
+// Each lane is a MultiplexTransport. Multiplex::tick() only stages its
+// bytes (as per-edge set masks); the group's tick() runs every member due
+// this tick, then shifts and latches all staged lanes together.
+// Shorter chains get their bytes at the END of the stream – the leading
+// bits fall off the far end of the chain.
+template <uint8_t CLOCK_PIN, typename... Lanes>
+class ParallelShift
+{
+public:
+    static_assert(CLOCK_PIN < 32, "GPIO.out_w1ts/w1tc only cover GPIO0-31");
+
+    static constexpr uint8_t LANES = sizeof...(Lanes);
+    static constexpr uint8_t MAX_REGS = maxLaneRegs(Lanes::REGS...);
+    static constexpr uint8_t EDGES = MAX_REGS * 8;
+
+    static constexpr uint32_t CLOCK_MASK = 1UL << CLOCK_PIN;
+    static constexpr uint32_t DATA_MASK = (Lanes::DATA_MASK | ...);
+    static constexpr uint8_t DATA_PINS[LANES] = {Lanes::DATA...};
+    static constexpr uint8_t LATCH_PINS[LANES] = {Lanes::LATCH...};
+
+    explicit ParallelShift(uint32_t refreshUs)
+        : refreshUs(refreshUs)
+    {
+        for (uint8_t i = 0; i < LANES; i++)
+        {
+            lanes[i].group = this;
+            lanes[i].index = i;
+        }
+    }
+
+    MultiplexTransport &lane(uint8_t i)
+    {
+        return lanes[i];
+    }
+
+    // Member chains tick from the group instead of their own Ticker
+    template <typename Mux>
+    bool add(Mux &mux)
+    {
+        if (memberCount >= LANES)
+            return false;
+
+        uint32_t period = mux.refreshPeriodUs() / refreshUs;
+        if (period == 0)
+            period = 1;
+
+        Member &m = members[memberCount++];
+        m.fn = &tickThunk<Mux>;
+        m.obj = &mux;
+        m.periodTicks = period;
+        m.countdown = 1; // no stagger – the point is to shift together
+
+        mux.setScheduled(true);
+        return true;
+    }
+
+    // --- MuxScheduler client
+    bool isrSafe() const
+    {
+        return true;
+    }
+
+    uint32_t refreshPeriodUs() const
+    {
+        return refreshUs;
+    }
+
+    void setScheduled(bool)
+    {
+    }
+
+    void IRAM_ATTR tick()
+    {
+        for (uint8_t i = 0; i < memberCount; i++)
+        {
+            Member &m = members[i];
+            if (--m.countdown == 0)
+            {
+                m.countdown = m.periodTicks;
+                m.fn(m.obj);
+            }
+        }
+
+        shift();
+    }
+
+private:
+    class Lane : public MultiplexTransport
+    {
+    public:
+        Lane()
+        {
+            direct = &directWrite<Lane>;
+        }
+
+        void begin() override
+        {
+            pinMode(CLOCK_PIN, OUTPUT);
+            pinMode(DATA_PINS[index], OUTPUT);
+            pinMode(LATCH_PINS[index], OUTPUT);
+            digitalWrite(LATCH_PINS[index], HIGH);
+        }
+
+        void IRAM_ATTR write(const uint8_t *regs, uint8_t numRegs) override
+        {
+            group->stage(index, regs, numRegs);
+        }
+
+        ParallelShift *group = nullptr;
+        uint8_t index = 0;
+    };
+
+    struct Member
+    {
+        void (*fn)(void *);
+        void *obj;
+        uint32_t periodTicks;
+        uint32_t countdown;
+    };
+
+    template <typename T>
+    static void IRAM_ATTR tickThunk(void *obj)
+    {
+        static_cast<T *>(obj)->tick();
+    }
+
+    // Fold one lane's bytes into the per-edge set masks
+    void IRAM_ATTR stage(uint8_t lane, const uint8_t *regs, uint8_t numRegs)
+    {
+        const uint32_t dm = dataMasks[lane];
+        if (numRegs > laneRegs[lane])
+            numRegs = laneRegs[lane];
+
+        for (uint8_t k = 0; k < numRegs; k++)
+        {
+            // regs[0] goes out last, so it sits at the end of the stream
+            uint32_t *edge = &setMasks[(MAX_REGS - 1 - k) * 8];
+            uint8_t value = regs[k];
+
+            for (int8_t bit = 7; bit >= 0; bit--, edge++)
+            {
+                if (value & (1 << bit))
+                    *edge |= dm;
+                else
+                    *edge &= ~dm;
+            }
+        }
+
+        pendingLatch |= latchMasks[lane];
+    }
+
+    void IRAM_ATTR shift()
+    {
+        uint32_t latch = pendingLatch;
+        if (!latch)
+            return;
+
+        GPIO.out_w1tc = latch;
+
+        for (uint8_t e = 0; e < EDGES; e++)
+        {
+            uint32_t set = setMasks[e];
+            GPIO.out_w1tc = (DATA_MASK & ~set) | CLOCK_MASK;
+            GPIO.out_w1ts = set;
+            GPIO.out_w1ts = CLOCK_MASK; // rising edge samples every lane
+        }
+
+        GPIO.out_w1tc = CLOCK_MASK;
+        GPIO.out_w1ts = latch;
+        pendingLatch = 0;
+    }
+
+    Lane lanes[LANES];
+    Member members[LANES]{};
+    uint8_t memberCount = 0;
+    uint32_t refreshUs;
+
+    // Per-lane tables indexed by the ISR: members (DRAM), not static
+    // constexpr arrays, which would sit in flash
+    uint32_t dataMasks[LANES] = {Lanes::DATA_MASK...};
+    uint32_t latchMasks[LANES] = {Lanes::LATCH_MASK...};
+    uint8_t laneRegs[LANES] = {Lanes::REGS...};
+
+    uint32_t setMasks[EDGES]{};
+    uint32_t pendingLatch = 0;
+};
+
+#endif // NINA_PARALLELSHIFT_H
@@ -0,0 +1,123 @@
+#include "SpiDmaTransport.h"
+
+#include <esp_rom_gpio.h>
+#include <soc/gpio_sig_map.h>
+#include <soc/gpio_struct.h>
+#include <soc/spi_periph.h>
+
+// One bus init per SPI host, shared by every chain on it
+static bool busReady[SOC_SPI_PERIPH_NUM] = {false};
+
+static inline void IRAM_ATTR latchWrite(uint8_t pin, bool high)
+{
+    if (pin < 32)
+    {
+        if (high)
+            GPIO.out_w1ts = 1UL << pin;
+        else
+            GPIO.out_w1tc = 1UL << pin;
+    }
+    else
+    {
+        if (high)
+            GPIO.out1_w1ts.val = 1UL << (pin - 32);
+        else
+            GPIO.out1_w1tc.val = 1UL << (pin - 32);
+    }
+}
+
+SpiDmaTransport::SpiDmaTransport(
+    spi_host_device_t host,
+    uint8_t dataPin,
+    uint8_t clockPin,
+    uint8_t latchPin,
+    uint32_t clockHz)
+    : host(host),
+      dataPin(dataPin),
+      clockPin(clockPin),
+      latchPin(latchPin),
+      clockHz(clockHz)
+{
+}
+
+void SpiDmaTransport::begin()
+{
+    pinMode(dataPin, OUTPUT);
+    pinMode(latchPin, OUTPUT);
+    digitalWrite(latchPin, HIGH);
+
+    if (!busReady[host])
+    {
+        spi_bus_config_t bus{};
+        bus.mosi_io_num = -1; // routed per chain in preTransfer()
+        bus.miso_io_num = -1;
+        bus.sclk_io_num = clockPin;
+        bus.quadwp_io_num = -1;
+        bus.quadhd_io_num = -1;
+        bus.max_transfer_sz = MAX_REGS;
+
+        if (spi_bus_initialize(host, &bus, SPI_DMA_CH_AUTO) != ESP_OK)
+            return;
+
+        busReady[host] = true;
+    }
+
+    spi_device_interface_config_t dev{};
+    dev.mode = 0; // 74HC595 samples on rising SRCLK
+    dev.clock_speed_hz = clockHz;
+    dev.spics_io_num = -1;
+    dev.queue_size = 1;
+    dev.pre_cb = preTransfer;
+    dev.post_cb = postTransfer;
+
+    if (spi_bus_add_device(host, &dev, &device) != ESP_OK)
+        device = nullptr;
+}
+
+void SpiDmaTransport::write(const uint8_t *regs, uint8_t numRegs)
+{
+    if (!device || numRegs > MAX_REGS)
+        return;
+
+    if (inFlight)
+    {
+        spi_transaction_t *done = nullptr;
+        if (spi_device_get_trans_result(device, &done, 0) != ESP_OK)
+            return; // previous frame still on the wire – drop this one
+
+        inFlight = false;
+    }
+
+    // MSB first, last register first – same bit stream as shiftOut()
+    for (uint8_t i = 0; i < numRegs; i++)
+    {
+        txBuf[i] = regs[numRegs - 1 - i];
+    }
+
+    trans.length = numRegs * 8;
+    trans.tx_buffer = txBuf;
+    trans.user = this;
+
+    if (spi_device_queue_trans(device, &trans, 0) == ESP_OK)
+        inFlight = true;
+}
+
+// Runs in the SPI ISR right before the DMA transfer starts
+void IRAM_ATTR SpiDmaTransport::preTransfer(spi_transaction_t *t)
+{
+    auto *self = static_cast<SpiDmaTransport *>(t->user);
+
+    latchWrite(self->latchPin, false);
+    esp_rom_gpio_connect_out_signal(
+        self->dataPin, spi_periph_signal[self->host].spid_out, false, false);
+}
+
+// Runs in the SPI ISR once the last bit is clocked out
+void IRAM_ATTR SpiDmaTransport::postTransfer(spi_transaction_t *t)
+{
+    auto *self = static_cast<SpiDmaTransport *>(t->user);
+
+    // Hand the data pin back to plain GPIO so the next chain owns MOSI
+    esp_rom_gpio_connect_out_signal(self->dataPin, SIG_GPIO_OUT_IDX, false, false);
+    latchWrite(self->latchPin, true);
+}
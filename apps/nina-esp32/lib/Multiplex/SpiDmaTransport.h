@@ -0,0 +1,50 @@
+#ifndef NINA_SPIDMATRANSPORT_H
+#define NINA_SPIDMATRANSPORT_H
+
+#pragma once
+
+#include <Arduino.h>
+#include <driver/spi_master.h>
+#include "MultiplexTransport.h"
+
+// Hardware SPI backend: the whole chain (1, 2 or 4 × 74HC595) goes out in
+// one DMA transaction, the latch is raised from the post-transfer callback.
+//
+// All chains on one SPI host share SRCLK as SCLK. Each chain is a CS-less
+// device; MOSI is routed to that chain's data pin through the GPIO matrix
+// right before its transfer starts.
+//
+// Not ISR-safe: write() queues through the spi_master driver.
+class SpiDmaTransport : public MultiplexTransport
+{
+public:
+    static constexpr uint8_t MAX_REGS = 4;
+
+    SpiDmaTransport(
+        spi_host_device_t host,
+        uint8_t dataPin,
+        uint8_t clockPin,
+        uint8_t latchPin,
+        uint32_t clockHz);
+
+    void begin() override;
+    void write(const uint8_t *regs, uint8_t numRegs) override;
+    bool isrSafe() const override { return false; }
+
+private:
+    static void IRAM_ATTR preTransfer(spi_transaction_t *t);
+    static void IRAM_ATTR postTransfer(spi_transaction_t *t);
+
+    spi_host_device_t host;
+    uint8_t dataPin, clockPin, latchPin;
+    uint32_t clockHz;
+
+    spi_device_handle_t device = nullptr;
+    spi_transaction_t trans{};
+    bool inFlight = false;
+
+    // DMA reads straight from here – keep it word aligned, never on flash
+    alignas(4) uint8_t txBuf[MAX_REGS]{};
+};
+
+#endif // NINA_SPIDMATRANSPORT_H
@@ -0,0 +1,170 @@
+#include "OdoLog.h"
+#include <esp_rom_crc.h>
+
+OdoLog::OdoLog(const char *label, const Policy &policy)
+    : label(label), policy(policy)
+{
+}
+
+bool OdoLog::begin()
+{
+    part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (!part || part->size < 2 * SECTOR_SIZE)
+    {
+        part = nullptr;
+        return false;
+    }
+
+    slots = (part->size / SECTOR_SIZE) * RECORDS_PER_SECTOR;
+
+    // Newest valid record wins (serial-number compare survives seq wrap)
+    haveLast = false;
+    uint32_t lastSlot = 0;
+    Record r;
+
+    for (uint32_t slot = 0; slot < slots; slot++)
+    {
+        if (!readSlot(slot, r) || r.magic != MAGIC || r.crc != crcOf(r))
+            continue;
+
+        if (!haveLast || static_cast<int32_t>(r.seq - last.seq) > 0)
+        {
+            last = r;
+            lastSlot = slot;
+            haveLast = true;
+        }
+    }
+
+    nextSlot = haveLast ? (lastSlot + 1) % slots : 0;
+    return true;
+}
+
+bool OdoLog::restore(State &out) const
+{
+    if (!haveLast)
+        return false;
+
+    out.odoMeters = last.odoMeters;
+    out.tripMeters = last.tripMeters;
+    out.runSeconds = last.runSeconds;
+    out.fuelPct = last.fuelPct;
+    return true;
+}
+
+bool OdoLog::maybeCommit(const State &state, uint32_t nowMs)
+{
+    if (!part || sameDistance(state))
+        return false;
+
+    uint32_t elapsed = nowMs - lastCommitMs;
+    if (elapsed < policy.minIntervalMs)
+        return false;
+
+    uint32_t meters = haveLast ? state.odoMeters - last.odoMeters : state.odoMeters;
+    if (meters < policy.commitMeters && elapsed < policy.maxIntervalMs)
+        return false;
+
+    return commitNow(state, nowMs);
+}
+
+bool OdoLog::commitNow(const State &state, uint32_t nowMs)
+{
+    if (!part || sameAsLast(state))
+        return false;
+
+    if (!append(state))
+        return false;
+
+    lastCommitMs = nowMs;
+    commitCount++;
+    return true;
+}
+
+bool OdoLog::append(const State &state)
+{
+    Record r{};
+    r.magic = MAGIC;
+    r.version = VERSION;
+    r.fuelPct = state.fuelPct;
+    r.seq = haveLast ? last.seq + 1 : 1;
+    r.odoMeters = state.odoMeters;
+    r.tripMeters = state.tripMeters;
+    r.runSeconds = state.runSeconds;
+    r.crc = crcOf(r);
+
+    // A few tries: a slot left dirty by a torn write is skipped
+    for (uint8_t attempt = 0; attempt < 4; attempt++)
+    {
+        uint32_t slot = nextSlot;
+        uint32_t offset = slot * sizeof(Record);
+
+        // Entering a sector: erase it (it holds the oldest records)
+        if (slot % RECORDS_PER_SECTOR == 0)
+        {
+            if (esp_partition_erase_range(part, offset, SECTOR_SIZE) != ESP_OK)
+                return false;
+        }
+        else
+        {
+            Record probe;
+            if (!readSlot(slot, probe))
+                return false;
+
+            if (!isBlank(probe))
+            {
+                // Skip the rest of this sector
+                nextSlot = (slot / RECORDS_PER_SECTOR + 1) * RECORDS_PER_SECTOR % slots;
+                continue;
+            }
+        }
+
+        if (esp_partition_write(part, offset, &r, sizeof(r)) != ESP_OK)
+            return false;
+
+        Record check;
+        nextSlot = (slot + 1) % slots;
+        if (!readSlot(slot, check) || memcmp(&check, &r, sizeof(r)) != 0)
+            continue; // bad cell – try the next slot
+
+        last = r;
+        haveLast = true;
+        return true;
+    }
+
+    return false;
+}
+
+bool OdoLog::sameDistance(const State &state) const
+{
+    return haveLast &&
+           state.odoMeters == last.odoMeters &&
+           state.tripMeters == last.tripMeters;
+}
+
+bool OdoLog::sameAsLast(const State &state) const
+{
+    return sameDistance(state) &&
+           state.runSeconds == last.runSeconds &&
+           state.fuelPct == last.fuelPct;
+}
+
+bool OdoLog::readSlot(uint32_t slot, Record &r) const
+{
+    return esp_partition_read(part, slot * sizeof(Record), &r, sizeof(r)) == ESP_OK;
+}
+
+uint32_t OdoLog::crcOf(const Record &r)
+{
+    return esp_rom_crc32_le(0, reinterpret_cast<const uint8_t *>(&r), offsetof(Record, crc));
+}
+
+bool OdoLog::isBlank(const Record &r)
+{
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(&r);
+    for (size_t i = 0; i < sizeof(r); i++)
+    {
+        if (p[i] != 0xFF)
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,100 @@
+#ifndef NINA_ODOLOG_H
+#define NINA_ODOLOG_H
+
+#pragma once
+
+#include <Arduino.h>
+#include <esp_partition.h>
+
+// Append-only record log in a dedicated flash partition.
+//
+// Each commit appends one 32-byte record (sequence number + CRC) to the
+// next erased slot; sectors are used round-robin, so every sector is
+// erased once per full pass (wear leveling). begin() scans the whole log
+// and keeps the valid record with the highest sequence number.
+//
+// Power-fail safety: a record is only ever written into erased flash and
+// the previous record is never touched, so a torn write or a torn sector
+// erase only loses the record being written – its CRC fails and the scan
+// falls back to the one before. The sector holding the newest record is
+// never erased.
+class OdoLog
+{
+public:
+    struct State
+    {
+        uint32_t odoMeters;
+        uint32_t tripMeters;
+        uint32_t runSeconds;
+        uint8_t fuelPct;
+    };
+
+    struct Policy
+    {
+        uint32_t commitMeters; // commit after this much distance ...
+        uint32_t maxIntervalMs; // ... or this long with any distance change
+        uint32_t minIntervalMs; // never more often than this
+    };
+
+    OdoLog(const char *label, const Policy &policy);
+
+    // Find the partition and scan the log
+    bool begin();
+
+    // Last committed state (false on a blank log)
+    bool restore(State &out) const;
+
+    // Rate-limited by the policy; returns true if a record was written.
+    // Only distance (odo/trip) counts as a change here: run time ticks
+    // every second and fuel wobbles, so they ride along with the next
+    // distance record instead of forcing one.
+    bool maybeCommit(const State &state, uint32_t nowMs);
+
+    // Unconditional (power going down); skipped if no field changed
+    bool commitNow(const State &state, uint32_t nowMs);
+
+    uint32_t commits() const { return commitCount; }
+
+private:
+    static constexpr uint32_t SECTOR_SIZE = 4096;
+    static constexpr uint16_t MAGIC = 0x4F44; // "OD"
+    static constexpr uint8_t VERSION = 1;
+
+    struct Record
+    {
+        uint16_t magic;
+        uint8_t version;
+        uint8_t fuelPct;
+        uint32_t seq;
+        uint32_t odoMeters;
+        uint32_t tripMeters;
+        uint32_t runSeconds;
+        uint32_t reserved[2];
+        uint32_t crc; // over everything above
+    };
+
+    static_assert(sizeof(Record) == 32, "record must stay 32 bytes");
+    static constexpr uint32_t RECORDS_PER_SECTOR = SECTOR_SIZE / sizeof(Record);
+
+    static uint32_t crcOf(const Record &r);
+    static bool isBlank(const Record &r);
+
+    bool readSlot(uint32_t slot, Record &r) const;
+    bool append(const State &state);
+    bool sameDistance(const State &state) const;
+    bool sameAsLast(const State &state) const;
+
+    const char *label;
+    Policy policy;
+    const esp_partition_t *part = nullptr;
+    uint32_t slots = 0;
+
+    bool haveLast = false;
+    Record last{};
+    uint32_t nextSlot = 0;
+
+    uint32_t lastCommitMs = 0;
+    uint32_t commitCount = 0;
+};
+
+#endif // NINA_ODOLOG_H
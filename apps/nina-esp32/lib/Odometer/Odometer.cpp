@@ -0,0 +1,62 @@
+#include "Odometer.h"
+
+Odometer::Odometer(uint32_t umPerPulse)
+    : umPerPulse(umPerPulse)
+{
+}
+
+void Odometer::update(uint32_t totalPulses)
+{
+    // First reading only sets the baseline
+    if (!synced)
+    {
+        lastPulses = totalPulses;
+        synced = true;
+        return;
+    }
+
+    uint32_t delta = totalPulses - lastPulses;
+    lastPulses = totalPulses;
+
+    if (delta)
+        addPulses(delta);
+}
+
+void Odometer::addPulses(uint32_t pulses)
+{
+    uint64_t um = static_cast<uint64_t>(pulses) * umPerPulse;
+
+    accumulate(totalM, totalRemUm, um);
+    accumulate(tripM, tripRemUm, um);
+}
+
+void Odometer::accumulate(uint32_t &meters, uint32_t &remUm, uint64_t um)
+{
+    um += remUm;
+    meters += static_cast<uint32_t>(um / UM_PER_M);
+    remUm = static_cast<uint32_t>(um % UM_PER_M);
+}
+
+uint32_t Odometer::totalMeters() const
+{
+    return totalM;
+}
+
+uint32_t Odometer::tripMeters() const
+{
+    return tripM;
+}
+
+void Odometer::resetTrip()
+{
+    tripM = 0;
+    tripRemUm = 0;
+}
+
+void Odometer::restore(uint32_t totalMeters, uint32_t tripMeters)
+{
+    totalM = totalMeters;
+    totalRemUm = 0;
+    tripM = tripMeters;
+    tripRemUm = 0;
+}
@@ -0,0 +1,45 @@
+#ifndef NINA_ODOMETER_H
+#define NINA_ODOMETER_H
+
+#pragma once
+
+#include <Arduino.h>
+
+// Distance straight from hall pulse totals, in integer micrometres.
+// Each pulse adds exactly umPerPulse; the sub-metre remainder is carried,
+// so total and trip are exact to the pulse whatever the loop rate.
+class Odometer
+{
+public:
+    explicit Odometer(uint32_t umPerPulse);
+
+    // Feed the input's monotonic pulse total (wraps at 2^32 are fine)
+    void update(uint32_t totalPulses);
+
+    void addPulses(uint32_t pulses);
+
+    uint32_t totalMeters() const;
+    uint32_t tripMeters() const;
+
+    void resetTrip();
+
+    // Restore persisted values (call before the first update)
+    void restore(uint32_t totalMeters, uint32_t tripMeters);
+
+private:
+    static constexpr uint32_t UM_PER_M = 1000000;
+
+    static void accumulate(uint32_t &meters, uint32_t &remUm, uint64_t um);
+
+    uint32_t umPerPulse;
+
+    bool synced = false;
+    uint32_t lastPulses = 0;
+
+    uint32_t totalM = 0;
+    uint32_t totalRemUm = 0;
+    uint32_t tripM = 0;
+    uint32_t tripRemUm = 0;
+};
+
+#endif // NINA_ODOMETER_H
@@ -0,0 +1,86 @@
+#include "PulseCounter.h"
+
+PulseCounter::PulseCounter(pcnt_unit_t unit, uint8_t pin, Edge edge, uint16_t glitchNs)
+    : unit(unit), pin(pin), edge(edge), glitchNs(glitchNs)
+{
+}
+
+bool PulseCounter::begin()
+{
+    pcnt_config_t cfg = {};
+    cfg.pulse_gpio_num = pin;
+    cfg.ctrl_gpio_num = PCNT_PIN_NOT_USED;
+    cfg.channel = PCNT_CHANNEL_0;
+    cfg.unit = unit;
+    cfg.pos_mode = edge == Edge::Falling ? PCNT_COUNT_DIS : PCNT_COUNT_INC;
+    cfg.neg_mode = edge == Edge::Rising ? PCNT_COUNT_DIS : PCNT_COUNT_INC;
+    cfg.lctrl_mode = PCNT_MODE_KEEP;
+    cfg.hctrl_mode = PCNT_MODE_KEEP;
+    cfg.counter_h_lim = LIMIT;
+    cfg.counter_l_lim = -1; // never reached, we only count up
+
+    if (pcnt_unit_config(&cfg) != ESP_OK)
+        return false;
+
+    // Filter runs on the 80 MHz APB clock, 10-bit threshold
+    uint32_t filter = static_cast<uint32_t>(glitchNs) * 80 / 1000;
+    if (filter > 1023)
+        filter = 1023;
+
+    if (filter > 0)
+    {
+        pcnt_set_filter_value(unit, filter);
+        pcnt_filter_enable(unit);
+    }
+    else
+    {
+        pcnt_filter_disable(unit);
+    }
+
+    // Counter resets to 0 at H_LIM; the event keeps the high word
+    pcnt_event_enable(unit, PCNT_EVT_H_LIM);
+
+    // Shared by all units – already installed is fine
+    esp_err_t err = pcnt_isr_service_install(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE)
+        return false;
+
+    pcnt_isr_handler_add(unit, onLimit, this);
+
+    pcnt_counter_pause(unit);
+    pcnt_counter_clear(unit);
+    pcnt_counter_resume(unit);
+
+    wraps = 0;
+    lastTotal = 0;
+    return true;
+}
+
+void IRAM_ATTR PulseCounter::onLimit(void *arg)
+{
+    PulseCounter *self = static_cast<PulseCounter *>(arg);
+    self->wraps = self->wraps + 1;
+}
+
+uint32_t PulseCounter::total()
+{
+    uint32_t before, after;
+    int16_t count = 0;
+
+    // Re-read if the limit event landed in the middle
+    do
+    {
+        before = wraps;
+        pcnt_get_counter_value(unit, &count);
+        after = wraps;
+    } while (before != after);
+
+    uint32_t value = after * static_cast<uint32_t>(LIMIT) + static_cast<uint16_t>(count);
+
+    // Hardware wrapped but the event hasn't been serviced yet
+    if (static_cast<int32_t>(value - lastTotal) < 0)
+        value += LIMIT;
+
+    lastTotal = value;
+    return value;
+}
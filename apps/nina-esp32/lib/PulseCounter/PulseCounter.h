@@ -0,0 +1,47 @@
+#ifndef NINA_PULSECOUNTER_H
+#define NINA_PULSECOUNTER_H
+
+#pragma once
+
+#include <Arduino.h>
+#include <driver/pcnt.h>
+
+// Hardware pulse counting on one PCNT unit (classic ESP32 has 8).
+// Edges are counted by the peripheral behind its glitch filter, so the CPU
+// only sees one interrupt every LIMIT pulses (counter wrap). total() is a
+// free-running 32-bit count; callers take deltas instead of clearing, so no
+// pulse is lost between read and clear.
+class PulseCounter
+{
+public:
+    enum class Edge : uint8_t
+    {
+        Rising,
+        Falling,
+        Both
+    };
+
+    // glitchNs: pulses shorter than this are ignored (max ~12.7 µs)
+    PulseCounter(pcnt_unit_t unit, uint8_t pin, Edge edge, uint16_t glitchNs);
+
+    // Pin mode (pull-ups) is left to the owner
+    bool begin();
+
+    // Monotonic pulse count since begin(); wraps at 2^32
+    uint32_t total();
+
+private:
+    static constexpr int16_t LIMIT = 30000;
+
+    static void IRAM_ATTR onLimit(void *arg);
+
+    pcnt_unit_t unit;
+    uint8_t pin;
+    Edge edge;
+    uint16_t glitchNs;
+
+    volatile uint32_t wraps = 0; // written by onLimit only
+    uint32_t lastTotal = 0;
+};
+
+#endif // NINA_PULSECOUNTER_H
@@ -3,48 +3,33 @@
 //
 #include "RPM.h"
 
-RPMMeter::RPMMeter(Multiplex<4> &mux)
-    : multiplex(mux) {}
-
-void RPMMeter::begin()
+bool RPMMeter::begin()
 {
-    multiplex.setRenderer(render, this);
-    multiplex.start();
+    multiplex.enableFrameCache();
+    return multiplex.start();
 }
 
 void RPMMeter::setRPM(uint16_t rpm)
 {
-    rpm = constrain(rpm, 0, 8000);
+    uint16_t index = rpm / stepRpm;
+    if (index >= lutEntries)
+        index = lutEntries - 1;
 
-    uint8_t ledsToLight = map(rpm, 0, 8000, 0, TOTAL_LEDS);
+    // One table fetch + 4-byte copy – ISR just copies the published image
+    uint8_t *regs = multiplex.backFrame(0);
+    if (memcmp(regs, lut[index], CHANNELS) == 0)
+        return; // nothing to re-render
 
-    for (uint8_t i = 0; i < TOTAL_LEDS; i++)
-    {
-        ledStates[i] = (i < ledsToLight);
-    }
+    memcpy(regs, lut[index], CHANNELS);
+    multiplex.publish();
 }
 
-void RPMMeter::render(uint8_t /*channel*/, void *ctx, uint8_t *regs)
+void RPMMeter::setPattern(MuxPattern next)
 {
-    auto *self = static_cast<RPMMeter *>(ctx);
-
-    uint8_t ledIndex = 0;
-
-    // Rebuild the ENTIRE shift register chain every tick
-    for (uint8_t reg = 0; reg < CHANNELS; reg++)
-    {
-        uint8_t value = 0;
-        uint8_t bits = (reg == CHANNELS - 1) ? 5 : 8; // last register partial
-
-        for (uint8_t bit = 0; bit < bits; bit++)
-        {
-            if (ledIndex < TOTAL_LEDS && self->ledStates[ledIndex])
-            {
-                value |= (1 << bit); // LSB-first, matches old sr.set()
-            }
-            ledIndex++;
-        }
+    if (next == pattern)
+        return;
 
-        regs[reg] = value;
-    }
+    pattern = next;
+    multiplex.setChannelPattern(0, pattern);
+    multiplex.publish();
 }
@@ -8,6 +8,22 @@
 #include <Arduino.h>
 #include <Multiplex.h>
 
+// How RPM maps onto the 29-LED bar
+enum class RpmBarCurve : uint8_t
+{
+    Linear,      // 0 → max evenly
+    Progressive, // quadratic – more LEDs per rpm near the top
+    Redline      // 0 → redline on the first LEDs, redline → max on the last redLeds
+};
+
+// Register images for every quantized RPM step, built at compile time
+template <uint16_t ENTRIES>
+struct RpmBarLut
+{
+    uint16_t stepRpm;
+    uint8_t regs[ENTRIES][4];
+};
+
 class RPMMeter
 {
 
@@ -17,15 +33,102 @@ public:
 
     inline static constexpr uint8_t LEDS_PER_REG[CHANNELS] = {8, 8, 8, 5};
 
-    RPMMeter(Multiplex<4> &mux);
+    template <uint16_t ENTRIES>
+    RPMMeter(Multiplex<4> &mux, const RpmBarLut<ENTRIES> &lut)
+        : lut(lut.regs), lutEntries(ENTRIES), stepRpm(lut.stepRpm), multiplex(mux)
+    {
+    }
 
-    void begin();
+    // false if the chain has no refresh source (see Multiplex::start)
+    bool begin();
     void setRPM(uint16_t rpm);
 
+    // Whole-bar pattern, e.g. Strobe above redline as a shift light
+    void setPattern(MuxPattern pattern);
+
 private:
-    static void render(uint8_t channel, void *ctx, uint8_t *regs);
+    const uint8_t (*lut)[CHANNELS];
+    uint16_t lutEntries;
+    uint16_t stepRpm;
+    MuxPattern pattern = MuxPattern::Steady;
 
-    bool ledStates[TOTAL_LEDS] = {false};
     Multiplex<4> &multiplex;
 };
-#endif // NINA_RPM_H
\ No newline at end of file
+
+// -------------------------------------------------
+// Compile-time bar generation
+// -------------------------------------------------
+
+constexpr uint8_t rpmBarLeds(
+    RpmBarCurve curve,
+    uint32_t rpm,
+    uint32_t maxRpm,
+    uint32_t redlineRpm,
+    uint8_t redLeds)
+{
+    constexpr uint32_t total = RPMMeter::TOTAL_LEDS;
+
+    if (rpm >= maxRpm)
+        return total;
+
+    switch (curve)
+    {
+    case RpmBarCurve::Progressive: // 64-bit: 29 × rpm² overflows 32 bits
+        return static_cast<uint8_t>(uint64_t(total) * rpm * rpm / (uint64_t(maxRpm) * maxRpm));
+
+    case RpmBarCurve::Redline:
+        if (rpm < redlineRpm)
+            return static_cast<uint8_t>((total - redLeds) * rpm / redlineRpm);
+        return static_cast<uint8_t>(
+            (total - redLeds) + redLeds * (rpm - redlineRpm) / (maxRpm - redlineRpm));
+
+    case RpmBarCurve::Linear:
+    default:
+        return static_cast<uint8_t>(total * rpm / maxRpm); // same as old map()
+    }
+}
+
+constexpr uint16_t rpmBarEntries(uint16_t maxRpm, uint16_t stepRpm)
+{
+    return stepRpm ? maxRpm / stepRpm + 1 : 2;
+}
+
+// One entry per STEP_RPM from 0 to MAX_RPM; the last entry is the full bar
+template <uint16_t MAX_RPM, uint16_t STEP_RPM>
+constexpr RpmBarLut<rpmBarEntries(MAX_RPM, STEP_RPM)> makeRpmBarLut(
+    RpmBarCurve curve,
+    uint16_t redlineRpm = 0,
+    uint8_t redLeds = 0)
+{
+    static_assert(STEP_RPM > 0, "RPM bar step must be > 0");
+    static_assert(MAX_RPM % STEP_RPM == 0, "RPM bar step must divide max rpm (else the bar never fills)");
+    static_assert(MAX_RPM / STEP_RPM >= 1, "need at least 0 rpm and max rpm");
+
+    constexpr uint16_t ENTRIES = rpmBarEntries(MAX_RPM, STEP_RPM);
+    RpmBarLut<ENTRIES> out{};
+    out.stepRpm = STEP_RPM;
+
+    for (uint16_t i = 0; i < ENTRIES; i++)
+    {
+        uint8_t leds = rpmBarLeds(curve, uint32_t(i) * STEP_RPM, MAX_RPM, redlineRpm, redLeds);
+        uint8_t ledIndex = 0;
+
+        for (uint8_t reg = 0; reg < RPMMeter::CHANNELS; reg++)
+        {
+            uint8_t value = 0;
+
+            for (uint8_t bit = 0; bit < RPMMeter::LEDS_PER_REG[reg]; bit++)
+            {
+                if (ledIndex < leds)
+                    value |= (1 << bit); // LSB-first, matches old sr.set()
+                ledIndex++;
+            }
+
+            out.regs[i][reg] = value;
+        }
+    }
+
+    return out;
+}
+
+#endif // NINA_RPM_H
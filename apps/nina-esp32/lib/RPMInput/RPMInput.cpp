@@ -4,35 +4,178 @@
 
 #include "RPMInput.h"
 
-volatile uint32_t RPMInput::pulseCount = 0;
+void IRAM_ATTR RPMInput::isr(void *arg) {
+    RPMInput *self = static_cast<RPMInput *>(arg);
+    uint32_t now = ESP.getCycleCount();
 
-void IRAM_ATTR RPMInput::isr() {
-    pulseCount++;
+    // Ignition ringing: faster than maxRpm can't be a real pulse
+    if (now - self->lastStamp < self->minPeriodCycles)
+        return;
+
+    self->lastStamp = now;
+    self->events.push(now);
 }
 
-RPMInput::RPMInput(uint8_t p, uint16_t sm, uint8_t ppr)
-  : pin(p), sampleMs(sm), pulsesPerRev(ppr) {}
+RPMInput::RPMInput(
+    uint8_t p,
+    uint16_t sm,
+    uint8_t ppr,
+    Mode m,
+    uint8_t avg,
+    uint16_t stopMs,
+    uint16_t maxR)
+  : pin(p), sampleMs(sm), pulsesPerRev(ppr), mode(m),
+    avgPulses(avg == 0 ? 1 : (avg > MAX_AVG_PULSES ? MAX_AVG_PULSES : avg)),
+    stopTimeoutMs(stopMs), maxRpm(maxR) {}
+
+void RPMInput::setPulseCounter(PulseCounter &pc) {
+    counter = &pc;
+}
 
 void RPMInput::begin() {
+    cpuHz = ESP.getCpuFreqMHz() * 1000000UL;
+    minPeriodCycles = static_cast<uint32_t>(
+        60.0f * cpuHz / (static_cast<float>(maxRpm) * pulsesPerRev));
+
     pinMode(pin, INPUT_PULLUP);
-    attachInterrupt(pin, isr, FALLING);
+    if (counter) {
+        counter->begin();
+        lastCount = counter->total();
+    } else {
+        attachInterruptArg(pin, isr, this, FALLING);
+    }
     lastSampleMs = millis();
+    lastPulseMs = lastSampleMs;
 }
 
 void RPMInput::update() {
+    if (!counter)
+        drainEvents();
+
+    if (mode == Mode::Period && !counter)
+        updatePeriod();
+    else
+        updateWindow();
+
+    uint32_t nowUs = micros();
+    filteredRPM = chain.step(currentRPM, nowUs - lastFilterUs);
+    lastFilterUs = nowUs;
+}
+
+void RPMInput::drainEvents() {
+    uint32_t stamp;
+    bool any = false;
+
+    while (events.pop(stamp)) {
+        windowPulses++;
+        history[historyNext] = stamp;
+        historyNext = (historyNext + 1) % HISTORY;
+        if (historyCount < HISTORY)
+            historyCount++;
+        any = true;
+    }
+
+    if (any)
+        lastPulseMs = millis();
+
+    // Ring overflowed: the next stamp follows a gap, not a period
+    uint32_t drops = events.dropped();
+    if (drops != seenDrops) {
+        seenDrops = drops;
+        historyCount = 0;
+    }
+}
+
+void RPMInput::updateWindow() {
     uint32_t now = millis();
-    if (now - lastSampleMs >= sampleMs) {
-        uint32_t pulses = pulseCount;
-        pulseCount = 0;
+    uint32_t dtMs = now - lastSampleMs;
+    if (dtMs >= sampleMs) {
+        uint32_t pulses;
+        if (counter) {
+            uint32_t count = counter->total();
+            pulses = count - lastCount;
+            lastCount = count;
+        } else {
+            pulses = windowPulses;
+            windowPulses = 0;
+        }
 
         float revs = static_cast<float>(pulses) / pulsesPerRev;
-        float minutes = (sampleMs / 1000.0f) / 60.0f;
+        float minutes = (dtMs / 1000.0f) / 60.0f;
 
         currentRPM = static_cast<uint16_t>(revs / minutes);
+        exactRPM = currentRPM;
         lastSampleMs = now;
     }
 }
 
+void RPMInput::updatePeriod() {
+    if (millis() - lastPulseMs >= stopTimeoutMs) {
+        // Engine stopped – the next start must not see the gap as a period
+        historyCount = 0;
+        currentRPM = 0;
+        exactRPM = 0.0f;
+        return;
+    }
+
+    if (historyCount < 2)
+        return; // keep the last value until there is a full period
+
+    uint8_t n = historyCount - 1 > avgPulses ? avgPulses : historyCount - 1;
+
+    // Newest first: periods[i] = stamp(i) - stamp(i + 1)
+    uint32_t periods[MAX_AVG_PULSES];
+    uint8_t idx = (historyNext + HISTORY - 1) % HISTORY;
+    uint32_t newest = history[idx];
+    for (uint8_t i = 0; i < n; i++) {
+        uint8_t prev = (idx + HISTORY - 1) % HISTORY;
+        periods[i] = history[idx] - history[prev];
+        idx = prev;
+    }
+
+    // Median (insertion sort, n ≤ 8) as the reference for outliers
+    uint32_t sorted[MAX_AVG_PULSES];
+    for (uint8_t i = 0; i < n; i++) {
+        uint32_t v = periods[i];
+        int8_t j = i - 1;
+        while (j >= 0 && sorted[j] > v) {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = v;
+    }
+    uint32_t median = sorted[n / 2];
+
+    // Average the periods within ±25 % of the median; a stray spark that
+    // slipped past the ISR filter splits one period and lands outside.
+    uint64_t sum = 0;
+    uint8_t used = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        uint32_t p = periods[i];
+        if (p < median - median / 4 || p > median + median / 4)
+            continue;
+        sum += p;
+        used++;
+    }
+    if (used == 0)
+        return;
+
+    float period = static_cast<float>(sum) / used;
+
+    // Decelerating: once the open period is longer than the average,
+    // it is the better (lower) estimate.
+    uint32_t open = ESP.getCycleCount() - newest;
+    if (open > period)
+        period = open;
+
+    exactRPM = 60.0f * cpuHz / (period * pulsesPerRev);
+    currentRPM = exactRPM > 65535.0f ? 65535 : static_cast<uint16_t>(exactRPM + 0.5f);
+}
+
 uint16_t RPMInput::rpm() const {
-    return currentRPM;
-}
\ No newline at end of file
+    return filteredRPM;
+}
+
+float RPMInput::rpmExact() const {
+    return exactRPM;
+}
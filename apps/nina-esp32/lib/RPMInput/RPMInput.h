@@ -6,25 +6,86 @@
 #define NINA_RPMINPUT_H
 #pragma once
 #include <Arduino.h>
+#include <PulseCounter.h>
+#include <SpscRing.h>
+#include <Filters.h>
 
 class RPMInput {
 public:
-    RPMInput(uint8_t pin, uint16_t sampleMs, uint8_t pulsesPerRev);
+    enum class Mode : uint8_t {
+        Window, // count pulses over sampleMs
+        Period  // average the last N inter-pulse periods
+    };
+
+    RPMInput(
+        uint8_t pin,
+        uint16_t sampleMs,
+        uint8_t pulsesPerRev,
+        Mode mode = Mode::Window,
+        uint8_t avgPulses = 4,
+        uint16_t stopTimeoutMs = 500,
+        uint16_t maxRpm = 12000);
+
+    // Count on a PCNT unit instead of the edge ISR (call before begin).
+    // There are no per-pulse timestamps then, so Period mode falls back
+    // to Window counting.
+    void setPulseCounter(PulseCounter &counter);
 
     void begin();
     void update();
 
-    uint16_t rpm() const;
+    uint16_t rpm() const;   // smoothed (30 ms time constant)
+    float rpmExact() const; // last measurement; Period mode keeps the fraction
 
 private:
-    static void IRAM_ATTR isr();
-    static volatile uint32_t pulseCount;
+    static constexpr uint8_t MAX_AVG_PULSES = 8;
+    static constexpr uint8_t HISTORY = MAX_AVG_PULSES + 1;
+
+    // ~160 ms of pulses at 12000 rpm × 2 – covers a slow display frame
+    static constexpr uint32_t EVENT_RING = 64;
+
+    // Per-instance: any number of tach inputs can coexist
+    static void IRAM_ATTR isr(void *arg);
+
+    // --- ISR → loop: one cycle-count stamp per accepted pulse
+    SpscRing<uint32_t, EVENT_RING> events;
+    uint32_t lastStamp = 0;       // ISR only
+    uint32_t minPeriodCycles = 0; // set in begin()
+
+    void drainEvents();
+    void updateWindow();
+    void updatePeriod();
 
     uint8_t pin;
     uint16_t sampleMs;
     uint8_t pulsesPerRev;
+    Mode mode;
+    uint8_t avgPulses;
+    uint16_t stopTimeoutMs;
+    uint16_t maxRpm;
+
+    PulseCounter *counter = nullptr;
+    uint32_t lastCount = 0;
+
     uint32_t lastSampleMs = 0;
-    uint16_t currentRPM = 0;
+    uint16_t currentRPM = 0; // last measurement
+    float exactRPM = 0.0f;
+
+    // Smoothing in real time, however often update() runs
+    using RpmChain = FilterChain<EmaFilter<30>>;
+    RpmChain chain;
+    uint16_t filteredRPM = 0;
+    uint32_t lastFilterUs = 0;
+
+    uint32_t windowPulses = 0;
+    uint32_t seenDrops = 0;
+
+    // --- Period mode bookkeeping
+    uint32_t cpuHz = 0;          // cycle counter rate
+    uint32_t history[HISTORY]{}; // last stamps, newest at historyNext - 1
+    uint8_t historyNext = 0;
+    uint8_t historyCount = 0;    // 0 after a stop or a dropped event
+    uint32_t lastPulseMs = 0;
 };
 
-#endif //NINA_RPMINPUT_H
\ No newline at end of file
+#endif //NINA_RPMINPUT_H
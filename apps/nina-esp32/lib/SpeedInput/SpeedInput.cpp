@@ -1,14 +1,12 @@
 #include "SpeedInput.h"
 
 // ======================
-// ISR state
+// ISR (per instance)
 // ======================
 
-volatile uint32_t SpeedInput::pulseCount = 0;
-
-void IRAM_ATTR SpeedInput::isr()
+void IRAM_ATTR SpeedInput::isr(void *arg)
 {
-	pulseCount++;
+	static_cast<SpeedInput *>(arg)->events.push(micros());
 }
 
 // ======================
@@ -16,43 +14,73 @@ void IRAM_ATTR SpeedInput::isr()
 // ======================
 
 SpeedInput::SpeedInput(uint8_t p, float mpp)
-	: pin(p), metersPerPulse(mpp) {}
+	: pin(p), metersPerPulse(mpp),
+	  estimator(mpp, 2, 40000, 1500000, 0.0f) {} // smoothing is done by chain
+
+void SpeedInput::setPulseCounter(PulseCounter &pc)
+{
+	counter = &pc;
+}
 
 void SpeedInput::begin()
 {
 	pinMode(pin, INPUT);
-	attachInterrupt(digitalPinToInterrupt(pin), isr, CHANGE);
-	lastSampleMs = millis();
+
+	if (counter)
+	{
+		counter->begin();
+		lastCount = counter->total();
+	}
+	else
+	{
+		attachInterruptArg(digitalPinToInterrupt(pin), isr, this, CHANGE);
+	}
+
 }
 
-void SpeedInput::update()
+void SpeedInput::drainEvents()
 {
-	uint32_t now = millis();
-	uint32_t dtMs = now - lastSampleMs;
-
-	if (dtMs < 100)
-		return; // 10 Hz update
+	uint32_t stamp;
+	while (events.pop(stamp))
+	{
+		estimator.addPulse(stamp);
+		totalPulses++;
+	}
+}
 
-	noInterrupts();
-	uint32_t pulses = pulseCount;
-	pulseCount = 0;
-	interrupts();
+void SpeedInput::update()
+{
+	if (counter)
+	{
+		// No edge stamps – the hardware count is stamped at read time
+		uint32_t count = counter->total();
+		uint32_t nowUs = micros();
+		estimator.addPulses(count - lastCount, nowUs);
+		totalPulses += count - lastCount;
+		lastCount = count;
+		estimator.update(nowUs);
+		filterSpeed(nowUs);
+		return;
+	}
 
-	float distanceMeters = pulses * metersPerPulse;
-	float speedMps = distanceMeters / (dtMs / 1000.0f);
-	float speedKph = speedMps * 3.6f;
+	drainEvents();
 
-	// smoothing
-	speedFiltered =
-		0.25f * speedKph +
-		0.75f * speedFiltered;
+	// After draining: every stamp handed over is older than nowUs
+	uint32_t nowUs = micros();
+	estimator.update(nowUs);
+	filterSpeed(nowUs);
+}
 
-	lastSampleMs = now;
+void SpeedInput::filterSpeed(uint32_t nowUs)
+{
+	int32_t raw = static_cast<int32_t>(estimator.rawSpeedKph() * 100.0f + 0.5f);
+	filteredCentiKph = chain.step(raw, nowUs - lastFilterUs);
+	lastFilterUs = nowUs;
 }
 
 float SpeedInput::speedKph() const
 {
-	return speedFiltered;
+	return filteredCentiKph * 0.01f;
 }
 
 // ======================
@@ -64,6 +92,7 @@ void SpeedInput::setMetersPerPulse(float mpp)
 	if (mpp > 0.0f)
 	{
 		metersPerPulse = mpp;
+		estimator.setMetersPerPulse(mpp);
 	}
 }
 
@@ -74,15 +103,21 @@ float SpeedInput::getMetersPerPulse() const
 
 void SpeedInput::resetPulseCounter()
 {
-	noInterrupts();
-	pulseCount = 0;
-	interrupts();
+	resetCount = totalPulses;
 }
 
 uint32_t SpeedInput::pulsesSinceReset() const
 {
-	noInterrupts();
-	uint32_t p = pulseCount;
-	interrupts();
-	return p;
+	// Counted as of the last update()
+	return totalPulses - resetCount;
+}
+
+uint32_t SpeedInput::totalPulseCount() const
+{
+	return totalPulses;
+}
+
+uint32_t SpeedInput::droppedPulses() const
+{
+	return events.dropped();
 }
\ No newline at end of file
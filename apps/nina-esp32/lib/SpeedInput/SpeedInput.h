@@ -1,11 +1,18 @@
 #pragma once
 #include <Arduino.h>
+#include <SpscRing.h>
+#include <SpeedEstimator.h>
+#include <PulseCounter.h>
+#include <Filters.h>
 
 class SpeedInput
 {
 public:
 	SpeedInput(uint8_t pin, float metersPerPulse);
 
+	// Count on a PCNT unit instead of the edge ISR (call before begin)
+	void setPulseCounter(PulseCounter &counter);
+
 	void begin();
 	void update();
 
@@ -19,13 +26,42 @@ public:
 	void resetPulseCounter();
 	uint32_t pulsesSinceReset() const;
 
+	// Monotonic pulse count since begin() (as of the last update, wraps at
+	// 2^32) – feed this to an Odometer
+	uint32_t totalPulseCount() const;
+
+	// Edges lost to a full event ring (loop stalled)
+	uint32_t droppedPulses() const;
+
 private:
-	static void IRAM_ATTR isr();
-	static volatile uint32_t pulseCount;
+	// Edge timestamps (micros) from the ISR; 256 edges ≈ 1.8 s at 250 km/h,
+	// enough to ride out a flash sector erase or an OTA chunk
+	static constexpr uint32_t EVENT_RING = 256;
+
+	// Per-instance: one SpeedInput per sensor, as many as needed
+	static void IRAM_ATTR isr(void *arg);
+	SpscRing<uint32_t, EVENT_RING> events;
+
+	void drainEvents();
 
 	uint8_t pin;
 	float metersPerPulse;
 
-	uint32_t lastSampleMs = 0;
-	float speedFiltered = 0.0f;
+	PulseCounter *counter = nullptr;
+	uint32_t lastCount = 0;
+
+	uint32_t totalPulses = 0; // since begin(), loop side
+	uint32_t resetCount = 0;  // totalPulses at resetPulseCounter()
+
+	// Period at low speed, timed count at high speed (unfiltered)
+	SpeedEstimator estimator;
+
+	// km/h × 100: 30 ms EMA, then at most 100 km/h per second – a wheel
+	// can't do more, a missed or doubled edge can
+	using SpeedChain = FilterChain<EmaFilter<30>, SlewLimitFilter<10000>>;
+	SpeedChain chain;
+	int32_t filteredCentiKph = 0;
+	uint32_t lastFilterUs = 0;
+
+	void filterSpeed(uint32_t nowUs);
 };
\ No newline at end of file
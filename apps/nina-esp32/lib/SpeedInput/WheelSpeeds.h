@@ -0,0 +1,105 @@
+#pragma once
+#include <Arduino.h>
+#include <utility>
+#include "SpeedInput.h"
+
+// N hall sensors (per wheel, driveshaft, ...) aggregated into one reading.
+// Inputs live inside this object – no heap, channel count fixed at compile
+// time. update() is O(N) on values SpeedInput already computed.
+template <uint8_t N>
+class WheelSpeeds
+{
+	static_assert(N >= 1, "need at least one channel");
+
+public:
+	static constexpr uint8_t CHANNELS = N;
+
+	// slipRatio: a channel further than this fraction from the average is
+	// slipping (only checked above minKph)
+	WheelSpeeds(const uint8_t (&pins)[N], float metersPerPulse, float slipRatio, float minKph)
+		: WheelSpeeds(pins, metersPerPulse, slipRatio, minKph, std::make_index_sequence<N>{})
+	{
+	}
+
+	SpeedInput &channel(uint8_t i)
+	{
+		return inputs[i];
+	}
+
+	void begin()
+	{
+		for (uint8_t i = 0; i < N; i++)
+		{
+			inputs[i].begin();
+		}
+	}
+
+	void update()
+	{
+		float sum = 0.0f;
+
+		for (uint8_t i = 0; i < N; i++)
+		{
+			inputs[i].update();
+			speeds[i] = inputs[i].speedKph();
+			sum += speeds[i];
+		}
+
+		avgKph = sum / N;
+
+		uint8_t mask = 0;
+		if (N > 1 && avgKph >= minKph)
+		{
+			float limit = avgKph * slipRatio;
+			for (uint8_t i = 0; i < N; i++)
+			{
+				if (fabsf(speeds[i] - avgKph) > limit)
+					mask |= 1 << i;
+			}
+		}
+		slip = mask;
+	}
+
+	float speedKph(uint8_t i) const
+	{
+		return speeds[i];
+	}
+
+	float averageKph() const
+	{
+		return avgKph;
+	}
+
+	// bit i = channel i slipping (spinning or locking)
+	uint8_t slipMask() const
+	{
+		return slip;
+	}
+
+	bool slipping() const
+	{
+		return slip != 0;
+	}
+
+private:
+	static_assert(N <= 8, "slipMask holds 8 channels");
+
+	template <size_t... I>
+	WheelSpeeds(
+		const uint8_t (&pins)[N],
+		float metersPerPulse,
+		float slipRatio,
+		float minKph,
+		std::index_sequence<I...>)
+		: inputs{{pins[I], metersPerPulse}...}, slipRatio(slipRatio), minKph(minKph)
+	{
+	}
+
+	SpeedInput inputs[N];
+	float speeds[N]{};
+	float avgKph = 0.0f;
+	uint8_t slip = 0;
+
+	float slipRatio;
+	float minKph;
+};
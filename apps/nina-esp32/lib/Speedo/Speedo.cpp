@@ -27,45 +27,78 @@ const uint8_t Speedo::digitStates[3] = {
 Speedo::Speedo(Multiplex<2> &mux)
     : multiplex(mux) {}
 
-void Speedo::begin()
+bool Speedo::begin()
 {
-    multiplex.setRenderer(render, this);
-    multiplex.start();
+    multiplex.enableFrameCache();
+    return multiplex.start();
 }
 
 void Speedo::setSpeed(uint16_t speed)
 {
     speed = constrain(speed, 0, 999);
-    digits[0] = speed / 100;
-    digits[1] = (speed / 10) % 10;
-    digits[2] = speed % 10;
+    if (speed == shownSpeed)
+        return; // nothing to re-render
+
+    shownSpeed = speed;
+
+    uint8_t digits[3] = {
+        static_cast<uint8_t>(speed / 100),
+        static_cast<uint8_t>((speed / 10) % 10),
+        static_cast<uint8_t>(speed % 10)};
+
+    // Pre-render all three digit channels, ISR just copies them
+    for (uint8_t channel = 0; channel < 3; channel++)
+    {
+        bool show = false;
+
+        if (channel == 2)
+        {
+            show = true;
+        }
+        else if (channel == 1)
+        {
+            show = digits[0] || digits[1];
+        }
+        else
+        {
+            show = digits[0];
+        }
+
+        uint8_t *regs = multiplex.backFrame(channel);
+
+        if (!show)
+        {
+            regs[0] = 0;
+            regs[1] = 0;
+            continue;
+        }
+
+        // IMPORTANT: register order swapped
+        // Segments are active-low, so BCM dimming works only because the
+        // digit-enable bit is modulated with the same level.
+        regs[0] = digitStates[channel];            // digit enable
+        regs[1] = segmentStates[digits[channel]]; // segments
+    }
+
+    multiplex.publish();
 }
 
-void Speedo::render(uint8_t channel, void *ctx, uint8_t *regs)
+void Speedo::setPattern(MuxPattern next)
 {
-    auto *self = static_cast<Speedo *>(ctx);
-    if (channel >= 3)
+    if (next == pattern)
         return;
 
-    bool show = false;
+    pattern = next;
 
-    if (channel == 2)
-    {
-        show = true;
-    }
-    else if (channel == 1)
+    // Blink the digit-enable register only – blanking an active-low
+    // segment bit would light it instead
+    for (uint8_t channel = 0; channel < 3; channel++)
     {
-        show = self->digits[0] || self->digits[1];
+        for (uint8_t output = 0; output < 8; output++)
+        {
+            multiplex.setPattern(channel, output, pattern);
+        }
     }
-    else
-    {
-        show = self->digits[0];
-    }
-
-    if (!show)
-        return;
 
-    // IMPORTANT: register order swapped
-    regs[0] = digitStates[channel];                 // digit enable
-    regs[1] = segmentStates[self->digits[channel]]; // segments
+    multiplex.publish();
 }
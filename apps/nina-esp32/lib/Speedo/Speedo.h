@@ -14,13 +14,16 @@ class Speedo
 public:
     Speedo(Multiplex<2> &mux);
 
-    void begin();
+    // false if the chain has no refresh source (see Multiplex::start)
+    bool begin();
     void setSpeed(uint16_t speed);
 
-private:
-    static void render(uint8_t channel, void *ctx, uint8_t *regs);
+    // Blink all digits (e.g. overspeed warning)
+    void setPattern(MuxPattern pattern);
 
-    uint8_t digits[3] = {0, 0, 0};
+private:
+    int16_t shownSpeed = -1; // force the first frame
+    MuxPattern pattern = MuxPattern::Steady;
     Multiplex<2> &multiplex;
 
     static const uint8_t segmentStates[10];
@@ -0,0 +1,78 @@
+#ifndef NINA_MONODEQUE_H
+#define NINA_MONODEQUE_H
+
+#pragma once
+
+#include <Arduino.h>
+
+// Sliding max (IS_MAX) or min over the last SLOTS pushed values.
+// Monotonic deque in a fixed ring: amortised O(1) per push, value() is
+// O(1), never more than SLOTS entries – no heap.
+template <typename T, uint16_t SLOTS, bool IS_MAX>
+class MonoDeque
+{
+public:
+    void push(T value)
+    {
+        // Expire the front once the new value pushes it out of the window
+        if (count && static_cast<uint16_t>(seq - at(0).seq) >= SLOTS)
+        {
+            head = (head + 1) % SLOTS;
+            count--;
+        }
+
+        // Drop entries the new value dominates – they can never win again
+        while (count && !beats(at(count - 1).value, value))
+            count--;
+
+        at(count) = {seq, value};
+        count++;
+        seq++;
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    // Undefined when empty()
+    T value() const
+    {
+        return at(0).value;
+    }
+
+    void clear()
+    {
+        head = 0;
+        count = 0;
+    }
+
+private:
+    struct Entry
+    {
+        uint16_t seq;
+        T value;
+    };
+
+    static bool beats(T kept, T incoming)
+    {
+        return IS_MAX ? kept > incoming : kept < incoming;
+    }
+
+    Entry &at(uint16_t i)
+    {
+        return ring[(head + i) % SLOTS];
+    }
+
+    const Entry &at(uint16_t i) const
+    {
+        return ring[(head + i) % SLOTS];
+    }
+
+    Entry ring[SLOTS]{};
+    uint16_t head = 0;
+    uint16_t count = 0;
+    uint16_t seq = 0;
+};
+
+#endif // NINA_MONODEQUE_H
@@ -0,0 +1,174 @@
+#include "TripStats.h"
+
+TripStats::TripStats(uint16_t rpmBandWidth, float movingKph)
+    : bandWidth(rpmBandWidth == 0 ? 1 : rpmBandWidth), movingKph(movingKph)
+{
+    reset();
+}
+
+void TripStats::reset()
+{
+    started = false;
+    maxSpeed = 0.0f;
+    maxEngineRpm = 0;
+    maxCoolant = INT16_MIN;
+    movingKmMs = 0.0;
+    movingMs = 0;
+    idleMs = 0;
+    memset(bandMs, 0, sizeof(bandMs));
+
+    for (Rolling &w : rolling)
+    {
+        w.speedMax.clear();
+        w.rpmMax.clear();
+        w.coolantMax.clear();
+        memset(w.sums, 0, sizeof(w.sums));
+        memset(w.counts, 0, sizeof(w.counts));
+        w.slot = 0;
+        w.sum = 0;
+        w.count = 0;
+        w.bSpeedMax = 0;
+        w.bRpmMax = 0;
+        w.bCoolantMax = INT16_MIN;
+        w.bSum = 0;
+        w.bCount = 0;
+    }
+}
+
+void TripStats::update(const Sample &s, uint32_t nowMs)
+{
+    if (!started)
+    {
+        started = true;
+        lastMs = nowMs;
+        lastSampleMs = nowMs;
+        sampleWindows(s);
+        return;
+    }
+
+    uint32_t dt = nowMs - lastMs;
+    lastMs = nowMs;
+
+    // --- running totals
+    if (s.speedKph > maxSpeed)
+        maxSpeed = s.speedKph;
+    if (s.rpm > maxEngineRpm)
+        maxEngineRpm = s.rpm;
+    if (s.coolantC > maxCoolant)
+        maxCoolant = s.coolantC;
+
+    if (s.speedKph >= movingKph)
+    {
+        movingMs += dt;
+        movingKmMs += static_cast<double>(s.speedKph) * dt;
+    }
+    else if (s.rpm > 0)
+    {
+        idleMs += dt;
+    }
+
+    if (s.rpm > 0)
+    {
+        uint8_t band = s.rpm / bandWidth;
+        if (band >= RPM_BANDS)
+            band = RPM_BANDS - 1;
+        bandMs[band] += dt;
+    }
+
+    // --- rolling windows at 1 Hz (catch up at most one sample per call)
+    if (nowMs - lastSampleMs >= 1000)
+    {
+        lastSampleMs += 1000;
+        if (nowMs - lastSampleMs >= 1000)
+            lastSampleMs = nowMs; // stalled – don't replay old samples
+
+        sampleWindows(s);
+    }
+}
+
+void TripStats::sampleWindows(const Sample &s)
+{
+    float kph = s.speedKph < 0.0f ? 0.0f : s.speedKph;
+    uint16_t speed = kph > 6553.0f ? 65535 : static_cast<uint16_t>(kph * 10.0f + 0.5f);
+
+    for (uint8_t i = 0; i < WINDOWS; i++)
+    {
+        Rolling &w = rolling[i];
+
+        if (speed > w.bSpeedMax)
+            w.bSpeedMax = speed;
+        if (s.rpm > w.bRpmMax)
+            w.bRpmMax = s.rpm;
+        if (s.coolantC > w.bCoolantMax)
+            w.bCoolantMax = s.coolantC;
+        w.bSum += speed;
+        w.bCount++;
+
+        if (w.bCount >= WINDOW_BUCKET_S[i])
+            closeBucket(w);
+    }
+}
+
+void TripStats::closeBucket(Rolling &w)
+{
+    w.speedMax.push(w.bSpeedMax);
+    w.rpmMax.push(w.bRpmMax);
+    w.coolantMax.push(w.bCoolantMax);
+
+    // Replace the oldest bucket in the running sum
+    w.sum -= w.sums[w.slot];
+    w.count -= w.counts[w.slot];
+    w.sums[w.slot] = w.bSum;
+    w.counts[w.slot] = w.bCount;
+    w.sum += w.bSum;
+    w.count += w.bCount;
+    w.slot = (w.slot + 1) % WINDOW_SLOTS;
+
+    w.bSpeedMax = 0;
+    w.bRpmMax = 0;
+    w.bCoolantMax = INT16_MIN;
+    w.bSum = 0;
+    w.bCount = 0;
+}
+
+float TripStats::avgMovingKph() const
+{
+    return movingMs ? static_cast<float>(movingKmMs / movingMs) : 0.0f;
+}
+
+uint32_t TripStats::bandSeconds(uint8_t band) const
+{
+    return band < RPM_BANDS ? bandMs[band] / 1000 : 0;
+}
+
+TripStats::Window TripStats::window(uint8_t i) const
+{
+    Window out{};
+    if (i >= WINDOWS)
+        return out;
+
+    const Rolling &w = rolling[i];
+
+    // Closed buckets + the one still filling
+    uint32_t count = w.count + w.bCount;
+    if (count == 0)
+        return out;
+
+    uint16_t speedMax = w.bSpeedMax;
+    uint16_t rpmMax = w.bRpmMax;
+    int16_t coolantMax = w.bCoolantMax;
+
+    if (!w.speedMax.empty())
+    {
+        speedMax = max(speedMax, w.speedMax.value());
+        rpmMax = max(rpmMax, w.rpmMax.value());
+        coolantMax = max(coolantMax, w.coolantMax.value());
+    }
+
+    out.avgKph = (w.sum + w.bSum) / (10.0f * count);
+    out.maxKph = speedMax / 10.0f;
+    out.maxRpm = rpmMax;
+    out.maxCoolantC = coolantMax;
+    out.valid = true;
+    return out;
+}
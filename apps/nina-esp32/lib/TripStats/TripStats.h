@@ -0,0 +1,102 @@
+#ifndef NINA_TRIPSTATS_H
+#define NINA_TRIPSTATS_H
+
+#pragma once
+
+#include <Arduino.h>
+#include "MonoDeque.h"
+
+// Trip computer: running totals updated on every sensor pass, plus
+// rolling 1 / 5 / 15-minute windows.
+//
+// Everything is fixed-size (~3 KB, no heap) and O(1) per update: the
+// windows sample at 1 Hz into 60 buckets each (1 s, 5 s, 15 s) and keep
+// max via monotonic deques and the average via a running bucket sum.
+// Window edges are therefore exact to one bucket.
+class TripStats
+{
+public:
+    static constexpr uint8_t RPM_BANDS = 8;
+    static constexpr uint8_t WINDOWS = 3;
+    static constexpr uint8_t WINDOW_SLOTS = 60;
+    static constexpr uint8_t WINDOW_BUCKET_S[WINDOWS] = {1, 5, 15};
+
+    struct Sample
+    {
+        float speedKph;
+        uint16_t rpm;
+        int16_t coolantC;
+    };
+
+    struct Window
+    {
+        float avgKph;
+        float maxKph;
+        uint16_t maxRpm;
+        int16_t maxCoolantC;
+        bool valid; // false until the first sample lands
+    };
+
+    // rpmBandWidth: band i covers [i × width, (i + 1) × width), the last
+    // band is open-ended. movingKph: slower counts as stopped.
+    TripStats(uint16_t rpmBandWidth, float movingKph);
+
+    void update(const Sample &sample, uint32_t nowMs);
+    void reset();
+
+    // --- whole trip
+    float avgMovingKph() const;
+    float maxKph() const { return maxSpeed; }
+    uint16_t maxRpm() const { return maxEngineRpm; }
+    int16_t maxCoolantC() const { return maxCoolant; }
+    uint32_t movingSeconds() const { return movingMs / 1000; }
+    uint32_t idleSeconds() const { return idleMs / 1000; } // engine on, stopped
+    uint32_t bandSeconds(uint8_t band) const;
+    uint16_t rpmBandWidth() const { return bandWidth; }
+
+    // 0 = 1 min, 1 = 5 min, 2 = 15 min
+    Window window(uint8_t i) const;
+
+private:
+    // One rolling window: 60 buckets, the newest one still filling
+    struct Rolling
+    {
+        MonoDeque<uint16_t, WINDOW_SLOTS, true> speedMax; // 0.1 km/h
+        MonoDeque<uint16_t, WINDOW_SLOTS, true> rpmMax;
+        MonoDeque<int16_t, WINDOW_SLOTS, true> coolantMax;
+
+        uint32_t sums[WINDOW_SLOTS]; // speed sum per bucket, 0.1 km/h
+        uint8_t counts[WINDOW_SLOTS];
+        uint8_t slot;
+        uint32_t sum;   // over closed buckets
+        uint16_t count; // samples in closed buckets
+
+        // bucket being filled
+        uint16_t bSpeedMax, bRpmMax;
+        int16_t bCoolantMax;
+        uint32_t bSum;
+        uint8_t bCount;
+    };
+
+    void sampleWindows(const Sample &sample);
+    void closeBucket(Rolling &w);
+
+    uint16_t bandWidth;
+    float movingKph;
+
+    bool started = false;
+    uint32_t lastMs = 0;
+    uint32_t lastSampleMs = 0;
+
+    float maxSpeed = 0.0f;
+    uint16_t maxEngineRpm = 0;
+    int16_t maxCoolant = INT16_MIN;
+    double movingKmMs = 0.0; // ∫ speed dt while moving (km/h × ms)
+    uint32_t movingMs = 0;
+    uint32_t idleMs = 0;
+    uint32_t bandMs[RPM_BANDS]{};
+
+    Rolling rolling[WINDOWS]{};
+};
+
+#endif // NINA_TRIPSTATS_H
@@ -1,4 +1,5 @@
 #include <Arduino.h>
+#include <array>
 
 // =====================
 // Hardware config
@@ -9,6 +10,9 @@
 // Core infrastructure
 // =====================
 #include <Multiplex.h>
+#include <SpiDmaTransport.h>
+#include <MuxScheduler.h>
+#include <ParallelShift.h>
 
 // =====================
 // Output modules
@@ -17,14 +21,22 @@
 #include <RPM.h>
 #include <DashLights.h>
 #include <Displays.h>
+#include <I2CBus.h>
 
 // =====================
 // Sensor modules
 // =====================
 #include <AnalogSensors.h>
+#include <AnalogLut.h>
+#include <AdcStream.h>
 #include <DigitalInputs.h>
 #include <RPMInput.h>
 #include <SpeedInput.h>
+#include <WheelSpeeds.h>
+#include <Odometer.h>
+#include <OdoLog.h>
+#include <TripStats.h>
+#include <PulseCounter.h>
 
 // =====================
 // WiFi & Network
@@ -39,14 +51,18 @@
 
 TwoWire I2C_FUEL(1); // Fuel OLED
 
+// One owner task per bus; devices are registered once they answer
+I2CBus bus0(Wire, I2C_CHUNK_BYTES);
+I2CBus bus1(I2C_FUEL, I2C_CHUNK_BYTES);
+
 // =====================
 // Display devices - will be initialized in setup() after I2C is ready
 // =====================
 
-Adafruit_SSD1306 *fuelDispPtr = nullptr;
-Adafruit_SSD1306 *tempDispPtr = nullptr;
+PartialSSD1306 *fuelDispPtr = nullptr;
+PartialSSD1306 *tempDispPtr = nullptr;
 // Main OLED (128x64 SSD1309) will be created in setup() after I2C is initialized
-Adafruit_SSD1306 *mainOledPtr = nullptr;
+PartialSSD1306 *mainOledPtr = nullptr;
 
 // =====================
 // Multiplexers
@@ -58,15 +74,15 @@ Multiplex<2> speedoMux(
     SRCLK,
     SPD_LATCH,
     3,
-    SPD_MUX_MS);
+    SPD_MUX_US);
 
-// RPM bar: 4 × 74HC595
+// RPM bar: 4 × 74HC595, static image (one channel, only shifted on change)
 Multiplex<4> rpmMux(
     RPM_DATA,
     SRCLK,
     RPM_LATCH,
-    RPMMeter::CHANNELS,
-    RPM_MUX_MS);
+    1,
+    RPM_MUX_US);
 
 // Dash warning lights: 1 × 74HC595
 Multiplex<1> dashMux(
@@ -74,14 +90,42 @@ Multiplex<1> dashMux(
     SRCLK,
     DASH_LATCH,
     1,
-    DASH_MUX_MS);
+    DASH_MUX_US);
+
+// One hardware timer refreshes all three chains
+MuxScheduler muxScheduler(MUX_TIMER_NUM, MUX_TICK_US);
+
+// All three chains shifted in parallel on SRCLK
+// (used when MUX_BACKEND == MuxBackend::ParallelGpio)
+ParallelShift<
+    SRCLK,
+    ShiftLane<SPD_DATA, SPD_LATCH, 2>,
+    ShiftLane<RPM_DATA, RPM_LATCH, 4>,
+    ShiftLane<DASH_DATA, DASH_LATCH, 1>>
+    muxGroup(MUX_TICK_US);
+
+// BitBang and SpiDma chains run on Ticker, which can't go below 1 ms
+static_assert(MUX_BACKEND == MuxBackend::ParallelGpio ||
+                  (RPM_MUX_US >= 1000 && SPD_MUX_US >= 1000 && DASH_MUX_US >= 1000),
+              "BitBang/SpiDma chains refresh on Ticker: *_MUX_US must be >= 1000");
+
+// SPI + DMA backends (used when MUX_BACKEND == MuxBackend::SpiDma)
+SpiDmaTransport speedoSpi(SPI3_HOST, SPD_DATA, SRCLK, SPD_LATCH, MUX_SPI_HZ);
+SpiDmaTransport rpmSpi(SPI3_HOST, RPM_DATA, SRCLK, RPM_LATCH, MUX_SPI_HZ);
+SpiDmaTransport dashSpi(SPI3_HOST, DASH_DATA, SRCLK, DASH_LATCH, MUX_SPI_HZ);
 
 // =====================
 // High-level output modules
 // =====================
 
+// RPM → 4-byte bar image, one entry per RPM_BAR_STEP_RPM (lives in flash)
+constexpr auto RPM_BAR_LUT = makeRpmBarLut<RPM_BAR_MAX_RPM, RPM_BAR_STEP_RPM>(
+    RPM_BAR_CURVE,
+    RPM_BAR_REDLINE_RPM,
+    RPM_BAR_RED_LEDS);
+
 Speedo speedo(speedoMux);
-RPMMeter rpm(rpmMux);
+RPMMeter rpm(rpmMux, RPM_BAR_LUT);
 DashLights dash(dashMux);
 
 // Displays object will be created in setup() after LCD detection
@@ -95,7 +139,7 @@ AnalogSensors::Pins analogPins{
     .temp = PIN_TEMP_ADC,
     .fuel = PIN_FUEL_ADC};
 
-AnalogSensorsConfig analogConfig{
+constexpr AnalogSensorsConfig analogConfig{
     .adcBits = ADC_BITS,
     .adcRefV = ADC_REF_V,
     .adcMax = ADC_MAX,
@@ -106,9 +150,16 @@ AnalogSensorsConfig analogConfig{
     .fuelAdcVMin = FUEL_ADC_V_MIN,
     .fuelAdcVMax = FUEL_ADC_V_MAX};
 
-AnalogSensors analogs(analogPins, analogConfig);
+// ADC count → °C / % for every 12-bit count, built by the compiler
+static_assert(ADC_MAX < AnalogLut::SIZE, "ADC_MAX exceeds the analog LUT");
+constexpr AnalogLut analogLut = makeAnalogLut(analogConfig);
+
+AnalogSensors analogs(analogPins, analogConfig, &analogLut);
+
+// DMA-backed ADC1 scan; shared by all analog inputs
+AdcStream adcStream(ADC_SAMPLE_HZ, ADC_OVERSAMPLE_BITS);
 
-DigitalInputs::Pins digitalPins{
+constexpr DigitalInputs::Pins digitalPins{
     PIN_BRAKE,
     PIN_OIL,
     PIN_INDICATORS,
@@ -117,23 +168,116 @@ DigitalInputs::Pins digitalPins{
     PIN_FOG,
     PIN_BATTERY};
 
-DigitalInputs digitalInputs(digitalPins);
+// GPIO register byte → packed input bits, built by the compiler
+constexpr DigitalInputs::PinMap digitalPinMap = DigitalInputs::makePinMap(digitalPins);
 
-RPMInput rpmInput(PIN_RPM, RPM_SAMPLE_MS, RPM_PULSES_PER_REV);
+DigitalInputs digitalInputs(digitalPins, digitalPinMap, DIGITAL_DEBOUNCE_SAMPLE_MS);
+
+RPMInput rpmInput(
+    PIN_RPM,
+    RPM_SAMPLE_MS,
+    RPM_PULSES_PER_REV,
+    RPM_MODE,
+    RPM_AVG_PULSES,
+    RPM_STOP_TIMEOUT_MS,
+    RPM_MAX_VALID);
 
 // =====================
 // SpeedoInput
 // =====================
 
-SpeedInput speedInput(PIN_HALL, SPEEDO_METERS_PER_PULSE);
+WheelSpeeds<WHEEL_SPEED_CHANNELS> wheels(
+    WHEEL_SPEED_PINS,
+    SPEEDO_METERS_PER_PULSE,
+    WHEEL_SLIP_RATIO,
+    WHEEL_SLIP_MIN_KPH);
+
+// PCNT backends (used when selected in HardwareConfig)
+PulseCounter rpmCounter(RPM_PCNT_UNIT, PIN_RPM, PulseCounter::Edge::Falling, RPM_GLITCH_NS);
+
+// One unit per wheel channel, SPEED_PCNT_UNIT upwards
+template <size_t... I>
+std::array<PulseCounter, sizeof...(I)> makeSpeedCounters(std::index_sequence<I...>)
+{
+  return {{PulseCounter(
+      static_cast<pcnt_unit_t>(SPEED_PCNT_UNIT + I),
+      WHEEL_SPEED_PINS[I],
+      PulseCounter::Edge::Both,
+      SPEED_GLITCH_NS)...}};
+}
+
+auto speedCounters = makeSpeedCounters(std::make_index_sequence<WHEEL_SPEED_CHANNELS>{});
 
 // =====================
 // Odometer & Trip
 // =====================
-// TODO: Store odometer in EEPROM/Flash to persist across power cycles
-uint32_t odometerMeters = 0; // Total meters traveled (for precision)
-uint32_t tripMeters = 0; // Trip distance in meters
-unsigned long lastOdometerUpdate = 0;
+// Integrated from raw hall pulses – exact to the pulse, loop-rate independent
+Odometer odometer(HALL_UM_PER_PULSE);
+
+// Persisted in the "odolog" flash partition (see partitions.csv)
+OdoLog odoLog(ODO_LOG_LABEL, {ODO_COMMIT_METERS, ODO_COMMIT_MAX_MS, ODO_COMMIT_MIN_MS});
+uint32_t runSecondsBase = 0; // restored run time
+
+// Trip computer: averages, maxima, RPM bands, 1/5/15-min windows
+TripStats tripStats(TRIP_RPM_BAND_WIDTH, TRIP_MOVING_KPH);
+
+// =====================
+// Input edge → dash light (GPIO ISR)
+// =====================
+// Warning lights (brake, oil, battery) must latch within a bounded time
+// whatever loop() is stuck in (web server, OTA, a flash erase); the
+// indicator and high beam follow the flasher relay / flash-to-pass.
+// These switch from the edge interrupt; DigitalInputs locks out bounce
+// and resyncs glitches, loop() still sets every light from the debounced
+// state. The gate only switches a lamp on/off – oil's Flash2Hz stays on
+// the published frame. Headlights and fog have nothing to race.
+struct LiveLight
+{
+  uint8_t input;
+  DashLights::Light light;
+  const char *name;
+};
+
+DRAM_ATTR static const LiveLight LIVE_LIGHTS[] = {
+    {DigitalInputs::BRAKE, DashLights::BRAKES, "brake"},
+    {DigitalInputs::OIL, DashLights::OIL, "oil"},
+    {DigitalInputs::BATTERY, DashLights::BATTERY, "battery"},
+    {DigitalInputs::INDICATORS, DashLights::INDICATORS, "indicators"},
+    {DigitalInputs::HIGH_BEAM, DashLights::HIGH_BEAM, "high beam"},
+};
+
+constexpr DigitalInputs::Mask LIVE_INPUTS =
+    (1 << DigitalInputs::BRAKE) | (1 << DigitalInputs::OIL) | (1 << DigitalInputs::BATTERY) |
+    (1 << DigitalInputs::INDICATORS) | (1 << DigitalInputs::HIGH_BEAM);
+constexpr uint8_t LIVE_DASH_LIGHTS =
+    (1 << DashLights::BRAKES) | (1 << DashLights::OIL) | (1 << DashLights::BATTERY) |
+    (1 << DashLights::INDICATORS) | (1 << DashLights::HIGH_BEAM);
+
+void IRAM_ATTR onInputEdge(void *, DigitalInputs::Mask level, DigitalInputs::Mask changed, uint32_t us)
+{
+  uint8_t on = 0;
+  uint8_t mask = 0;
+  for (const LiveLight &l : LIVE_LIGHTS)
+  {
+    if (!(changed & (1 << l.input)))
+      continue;
+
+    mask |= 1 << l.light;
+    if (level & (1 << l.input))
+      on |= 1 << l.light;
+  }
+
+  dash.setLiveLights(on, mask, us);
+}
+
+OdoLog::State persistState()
+{
+  return {
+      odometer.totalMeters(),
+      odometer.tripMeters(),
+      runSecondsBase + millis() / 1000,
+      analogs.fuelPercent()};
+}
 
 // =====================
 // WiFi Manager & OTA
@@ -173,10 +317,10 @@ void setup()
   Serial.println("Initializing hardware...");
 
   // Create OLED display objects NOW (after I2C is initialized)
-  static Adafruit_SSD1306 fuelDisp(128, 32, &I2C_FUEL, -1);
-  static Adafruit_SSD1306 tempDisp(128, 32, &Wire, -1);
+  static PartialSSD1306 fuelDisp(128, 32, &I2C_FUEL, -1);
+  static PartialSSD1306 tempDisp(128, 32, &Wire, -1);
   // Main OLED is on bus 1 at 0x3D (I2C scan confirmed this)
-  static Adafruit_SSD1306 mainOled(128, 64, &I2C_FUEL, -1); // 128x64 SSD1309 on bus 1
+  static PartialSSD1306 mainOled(128, 64, &I2C_FUEL, -1); // 128x64 SSD1309 on bus 1
   fuelDispPtr = &fuelDisp;
   tempDispPtr = &tempDisp;
   mainOledPtr = &mainOled;
@@ -343,30 +487,120 @@ void setup()
     Serial.printf("OLED addresses confirmed: Temp=0x%02X (bus 0), Main=0x%02X (bus 1)\n", tempOledAddr, mainOledAddr);
   }
 
+  // --- I2C scheduling: from here on transfers are queued per bus
+  if (tempOledConnected)
+    tempDisp.setBus(bus0, bus0.addDevice(tempOledAddr, OLED_I2C_MAX_HZ));
+  if (fuelOledConnected)
+    fuelDisp.setBus(bus1, bus1.addDevice(OLED_ADDR, OLED_I2C_MAX_HZ));
+  if (mainOledConnected)
+    mainOled.setBus(bus1, bus1.addDevice(mainOledAddr, OLED_I2C_MAX_HZ));
+
+  I2CBus *buses[] = {&bus0, &bus1};
+  for (uint8_t b = 0; b < 2; b++)
+  {
+    if (buses[b]->deviceCount() == 0)
+      continue;
+    if (buses[b]->begin(I2C_TASK_CORE, I2C_TASK_PRIORITY))
+      Serial.printf("I2C bus %u scheduled at %lu kHz\n", b, (unsigned long)buses[b]->clockHz() / 1000);
+    else
+      Serial.printf("I2C bus %u task failed, transfers run inline\n", b);
+  }
+
   // Create Displays object (after OLEDs are created and initialized)
   static Displays displays(fuelDisp, tempDisp, mainOledPtr);
   displaysPtr = &displays;
 
   // --- Multiplexers
+  if (MUX_BACKEND == MuxBackend::SpiDma)
+  {
+    speedoMux.setTransport(speedoSpi);
+    rpmMux.setTransport(rpmSpi);
+    dashMux.setTransport(dashSpi);
+  }
+  else if (MUX_BACKEND == MuxBackend::ParallelGpio)
+  {
+    speedoMux.setTransport(muxGroup.lane(0));
+    rpmMux.setTransport(muxGroup.lane(1));
+    dashMux.setTransport(muxGroup.lane(2));
+  }
+
   speedoMux.begin();
   rpmMux.begin();
   dashMux.begin();
 
-  // --- Output modules
-  speedo.begin();
-  rpm.begin();
-  dash.begin();
+  if (MUX_BACKEND == MuxBackend::ParallelGpio)
+  {
+    // Group ticks its chains and shifts them in one pass
+    muxGroup.add(speedoMux);
+    muxGroup.add(rpmMux);
+    muxGroup.add(dashMux);
+    muxScheduler.add(muxGroup);
+  }
+  else
+  {
+    muxScheduler.add(speedoMux);
+    muxScheduler.add(rpmMux);
+    muxScheduler.add(dashMux);
+  }
+
+  // --- Output modules (start() is a no-op for scheduled chains)
+  if (!speedo.begin())
+    Serial.println("Speedo mux has no refresh: period < 1 ms needs MuxScheduler");
+  if (!rpm.begin())
+    Serial.println("RPM mux has no refresh: period < 1 ms needs MuxScheduler");
+  if (!dash.begin())
+    Serial.println("Dash mux has no refresh: period < 1 ms needs MuxScheduler");
+
+  muxScheduler.begin();
 
   displaysPtr->begin(mainOledConnected, fuelOledConnected, tempOledConnected);
 
   // --- Sensor modules
+  analogs.setStream(adcStream);
   analogs.begin();
+  if (!adcStream.begin())
+  {
+    Serial.println("ADC stream failed, falling back to analogRead()");
+  }
+  if (DIGITAL_INPUT_EVENTS)
+  {
+    dash.enableLive(LIVE_DASH_LIGHTS);
+    digitalInputs.enableEvents(onInputEdge, nullptr, LIVE_INPUTS);
+  }
   digitalInputs.begin();
+
+  if (RPM_PULSE_BACKEND == PulseBackend::Pcnt)
+    rpmInput.setPulseCounter(rpmCounter);
+  if (SPEED_PULSE_BACKEND == PulseBackend::Pcnt)
+  {
+    for (uint8_t i = 0; i < WHEEL_SPEED_CHANNELS; i++)
+      wheels.channel(i).setPulseCounter(speedCounters[i]);
+  }
+
   rpmInput.begin();
+  wheels.begin();
+
+  // --- Persisted odometer / trip
+  OdoLog::State saved;
+  if (odoLog.begin() && odoLog.restore(saved))
+  {
+    odometer.restore(saved.odoMeters, saved.tripMeters);
+    runSecondsBase = saved.runSeconds;
+    Serial.printf("Odometer restored: %u m (trip %u m)\n", saved.odoMeters, saved.tripMeters);
+
+    if (analogs.restoreFuelPercent(saved.fuelPct, FUEL_RESTORE_TOLERANCE_PCT))
+      Serial.printf("Fuel level restored: %u%%\n", saved.fuelPct);
+  }
 
   if (mainOledConnected)
   {
-    displaysPtr->showOdometer(odometerMeters / 1000, tripMeters / 1000); // Convert meters to km
+    displaysPtr->showOdometer(odometer.totalMeters() / 1000, odometer.tripMeters() / 1000); // Convert meters to km
+  }
+
+  // From here on the OLEDs belong to the display task
+  if (!displaysPtr->startTask(DISPLAY_TASK_CORE, DISPLAY_TASK_PRIORITY, DISPLAY_FRAME_MS))
+  {
+    Serial.println("Display task failed, rendering from loop()");
   }
   
   Serial.println("Hardware setup complete");
@@ -475,12 +709,51 @@ void setupWebServer() {
     webServer->send(200, "text/html", html);
   });
   
+  // Trip computer as JSON
+  webServer->on("/trip", []() {
+    char buf[160];
+    String json = "{";
+
+    snprintf(buf, sizeof(buf),
+             "\"avgKph\":%.1f,\"maxKph\":%.1f,\"maxRpm\":%u,\"maxCoolantC\":%d,"
+             "\"movingS\":%lu,\"idleS\":%lu,",
+             tripStats.avgMovingKph(), tripStats.maxKph(), tripStats.maxRpm(),
+             tripStats.maxCoolantC() == INT16_MIN ? 0 : tripStats.maxCoolantC(),
+             (unsigned long)tripStats.movingSeconds(), (unsigned long)tripStats.idleSeconds());
+    json += buf;
+
+    snprintf(buf, sizeof(buf), "\"rpmBandWidth\":%u,\"bandS\":[", tripStats.rpmBandWidth());
+    json += buf;
+    for (uint8_t i = 0; i < TripStats::RPM_BANDS; i++)
+    {
+      snprintf(buf, sizeof(buf), "%s%lu", i ? "," : "", (unsigned long)tripStats.bandSeconds(i));
+      json += buf;
+    }
+    json += "],\"windows\":[";
+
+    for (uint8_t i = 0; i < TripStats::WINDOWS; i++)
+    {
+      TripStats::Window w = tripStats.window(i);
+      snprintf(buf, sizeof(buf),
+               "%s{\"minutes\":%u,\"avgKph\":%.1f,\"maxKph\":%.1f,\"maxRpm\":%u,\"maxCoolantC\":%d}",
+               i ? "," : "",
+               TripStats::WINDOW_BUCKET_S[i] * TripStats::WINDOW_SLOTS / 60,
+               w.avgKph, w.maxKph, w.maxRpm, w.valid ? w.maxCoolantC : 0);
+      json += buf;
+    }
+    json += "]}";
+
+    webServer->send(200, "application/json", json);
+  });
+
   webServer->begin();
   Serial.println("Web Server Started");
 }
 
 void loop()
 {
+  uint32_t loopStartUs = micros();
+
   // Handle WiFiManager (in case config portal is active)
   // This needs to be called regularly for config portal to work
   if (esp_wifiManager && WiFi.status() != WL_CONNECTED) {
@@ -520,13 +793,16 @@ void loop()
   }
   
   // --- Read sensors
+  adcStream.update();
   analogs.update();
   digitalInputs.update();
   rpmInput.update();
+  wheels.update();
 
   // --- Outputs
-  // rpm.setRPM(rpmInput.rpm());
-  rpm.setRPM(8000);
+  uint16_t engineRpm = rpmInput.rpm();
+  rpm.setRPM(engineRpm);
+  rpm.setPattern(engineRpm >= RPM_BAR_REDLINE_RPM ? MuxPattern::Strobe : MuxPattern::Steady);
 
   // TODO: real speed calculation later
   speedo.setSpeed(100);
@@ -540,6 +816,18 @@ void loop()
   dash.setFogLights(digitalInputs.fog());
   dash.setBattery(digitalInputs.battery());
 
+  // Oil lamp with the engine running = no pressure: flash it (from the
+  // refresh ISR, not loop() timing). Key on, engine off stays steady.
+  bool oilWarning = digitalInputs.oil() && engineRpm >= OIL_WARN_MIN_RPM;
+  dash.setLightPattern(DashLights::OIL, oilWarning ? MuxPattern::Flash2Hz : MuxPattern::Steady);
+
+  // --- Night dimming follows the headlight switch
+  bool night = digitalInputs.lights();
+  uint8_t ledLevel = night ? LED_LEVEL_NIGHT : LED_LEVEL_DAY;
+  speedoMux.setBrightness(ledLevel);
+  rpmMux.setBrightness(ledLevel);
+  dashMux.setBrightness(ledLevel);
+
     // dash.setBrakes(true);
   // dash.setOil(true);
   // dash.setIndicators(true);
@@ -550,40 +838,52 @@ void loop()
   // Low fuel warning (below 20%)
   dash.setLowFuel(analogs.fuelPercent() < LOW_FUEL_THRESHOLD);
 
-  // --- Displays (throttle updates to avoid flickering)
-  static unsigned long lastDisplayUpdate = 0;
   unsigned long now = millis();
-  if (now - lastDisplayUpdate >= 200)
-  { // Update displays every 200ms (5Hz)
-    lastDisplayUpdate = now;
 
-    displaysPtr->showFuel(analogs.fuelPercent());
-    displaysPtr->showTemp(analogs.tempPercent());
-  }
+  // Odometer & trip advance by whole pulses (µm remainders carried)
+  odometer.update(wheels.channel(ODOMETER_CHANNEL).totalPulseCount());
+
+  // Persist: bounded by distance and time, final record when D+ drops
+  static bool wasRunning = false;
+  bool running = digitalInputs.battery();
+  if (wasRunning && !running)
+    odoLog.commitNow(persistState(), now);
+  else
+    odoLog.maybeCommit(persistState(), now);
+  wasRunning = running;
 
-  // Update odometer based on speed (integrate speed over time)
-  if (lastOdometerUpdate > 0)
+  // Trip computer (constant time per pass)
+  tripStats.update({wheels.averageKph(), rpmInput.rpm(), analogs.tempC()}, now);
+
+  // --- Displays: post a snapshot, the display task renders and flushes
+  // it (odometer and trip pages rotate on the main OLED)
+  static unsigned long lastDisplayPost = 0;
+  if (now - lastDisplayPost >= DISPLAY_FRAME_MS)
   {
-    float speedKph = speedInput.speedKph();
-    if (speedKph > 0.1f)
-    { // Only update if moving (avoid drift when stationary)
-      unsigned long deltaMs = now - lastOdometerUpdate;
-      float deltaHours = deltaMs / 3600000.0f; // Convert ms to hours
-      float deltaKm = speedKph * deltaHours;
-      uint32_t deltaMeters = (uint32_t)(deltaKm * 1000.0f); // Convert to meters for precision
-      odometerMeters += deltaMeters;
-    }
-  }
-  lastOdometerUpdate = now;
-
-  // Display odometer on main OLED (throttled to avoid flickering)
-  static unsigned long lastOdometerDisplay = 0;
-  if (now - lastOdometerDisplay >= 500)
-  { // Update odometer display every 500ms (2Hz)
-    lastOdometerDisplay = now;
-    displaysPtr->showOdometer(odometerMeters / 1000, tripMeters / 1000);
+    lastDisplayPost = now;
+
+    Displays::Snapshot snap;
+    snap.screen = (now / MAIN_SCREEN_ROTATE_MS) % 2 ? Displays::Screen::Trip : Displays::Screen::Odometer;
+    snap.fuelPct = analogs.fuelPercent();
+    snap.tempPct = analogs.tempPercent();
+    snap.contrast = night ? OLED_CONTRAST_NIGHT : OLED_CONTRAST_DAY;
+    snap.odometerKm = odometer.totalMeters() / 1000;
+    snap.tripKm = odometer.tripMeters() / 1000;
+    snap.trip.avgKph = tripStats.avgMovingKph() + 0.5f;
+    snap.trip.maxKph = tripStats.maxKph() + 0.5f;
+    snap.trip.maxRpm = tripStats.maxRpm();
+    snap.trip.maxCoolantC = tripStats.maxCoolantC() == INT16_MIN ? 0 : tripStats.maxCoolantC();
+    snap.trip.movingMin = tripStats.movingSeconds() / 60;
+    snap.trip.idleMin = tripStats.idleSeconds() / 60;
+    displaysPtr->post(snap);
   }
 
+  // Worst loop() pass per log period, logger excluded
+  static uint32_t loopMaxUs = 0;
+  uint32_t loopUs = micros() - loopStartUs;
+  if (loopUs > loopMaxUs)
+    loopMaxUs = loopUs;
+
   // --- Logger (print state every second)
   static unsigned long lastLogMs = 0;
   if (now - lastLogMs >= 1000)
@@ -591,7 +891,8 @@ void loop()
     lastLogMs = now;
 
     Serial.println("\n=== Dashboard Status ===");
-    Serial.printf("Uptime: %lu s\n", now / 1000);
+    Serial.printf("Uptime: %lu s | loop max %lu us\n", now / 1000, (unsigned long)loopMaxUs);
+    loopMaxUs = 0;
     
     // WiFi status
     if (WiFi.status() == WL_CONNECTED) {
@@ -603,30 +904,42 @@ void loop()
 
     // Sensors
     Serial.println("\n--- Sensors ---");
-    Serial.printf("Temperature: %d°C (%.1f%%)\n", analogs.tempC(), analogs.tempPercent());
+    Serial.printf("Temperature: %d°C (%u%%)\n", analogs.tempC(), analogs.tempPercent());
 
-    // Fuel debug info
-    uint16_t rawFuel = analogRead(PIN_FUEL_ADC);
-    // Validate raw reading before calculating voltage
-    if (rawFuel > ADC_MAX)
+    // Fuel debug info (latest sample, no extra ADC read)
+    float rawFuel = analogs.fuelRaw();
+    if (rawFuel <= 0.0f)
     {
-      Serial.printf("Fuel: %.1f%% (Raw ADC: INVALID/%u, ADC_MAX: %u) - CHECK CONNECTIONS!\n",
-                    analogs.fuelPercent(), rawFuel, ADC_MAX);
-    }
-    else if (rawFuel == 0)
-    {
-      Serial.printf("Fuel: %.1f%% (Raw ADC: 0 - connection glitch, using filtered value)\n",
+      Serial.printf("Fuel: %u%% (Raw ADC: 0 - connection glitch, using filtered value)\n",
                     analogs.fuelPercent());
     }
     else
     {
       float fuelVoltage = (rawFuel / (float)ADC_MAX) * ADC_REF_V;
-      Serial.printf("Fuel: %.1f%% (Raw ADC: %u, Voltage: %.3fV, Min: %.2fV, Max: %.2fV)\n",
+      Serial.printf("Fuel: %u%% (Raw ADC: %.2f, Voltage: %.3fV, Min: %.2fV, Max: %.2fV)\n",
                     analogs.fuelPercent(), rawFuel, fuelVoltage, FUEL_ADC_V_MIN, FUEL_ADC_V_MAX);
     }
 
+    if (adcStream.running())
+    { // slots 0/1 = temp/fuel, registered by analogs.begin()
+      Serial.printf("ADC: %u-bit, raw p-p noise temp %u / fuel %u, overruns %lu\n",
+                    12 + adcStream.oversampleBits(),
+                    adcStream.rawSpread(0), adcStream.rawSpread(1),
+                    (unsigned long)adcStream.overruns());
+      Serial.printf("ADC noise SD (12-bit LSB), raw → decimated: temp %.2f → %.2f | fuel %.2f → %.2f\n",
+                    adcStream.rawNoise(0) / 100.0f, adcStream.valueNoise(0) / 100.0f,
+                    adcStream.rawNoise(1) / 100.0f, adcStream.valueNoise(1) / 100.0f);
+    }
+
     Serial.printf("RPM: %u\n", rpmInput.rpm());
-    Serial.printf("Speed: %.1f km/h\n", speedInput.speedKph());
+    Serial.printf("Speed: %.1f km/h", wheels.averageKph());
+    if (WHEEL_SPEED_CHANNELS > 1)
+    {
+      for (uint8_t i = 0; i < WHEEL_SPEED_CHANNELS; i++)
+        Serial.printf(" | ch%u %.1f", i, wheels.speedKph(i));
+      Serial.printf(" | slip 0x%02X", wheels.slipMask());
+    }
+    Serial.println();
 
     // Digital inputs
     Serial.println("\n--- Digital Inputs ---");
@@ -640,12 +953,72 @@ void loop()
                   digitalInputs.fog() ? "ON" : "OFF",
                   digitalInputs.battery() ? "ON" : "OFF");
 
+    if (DIGITAL_INPUT_EVENTS)
+    {
+      for (const LiveLight &l : LIVE_LIGHTS)
+      {
+        Multiplex<1>::LiveLatency lat = dash.liveLatency(l.light);
+        Serial.printf("Edge → %s latch: last %lu us | max %lu us | mean %lu us (%lu)\n",
+                      l.name, (unsigned long)lat.lastUs, (unsigned long)lat.maxUs,
+                      (unsigned long)lat.meanUs, (unsigned long)lat.samples);
+      }
+      Serial.printf("Input edge events %lu, dropped %lu\n",
+                    (unsigned long)digitalInputs.edgeEvents(),
+                    (unsigned long)digitalInputs.droppedEvents());
+
+      const DigitalInputs::FlashTiming &ft = digitalInputs.indicatorTiming();
+      Serial.printf("Indicator flash: period %u ms (min %u / max %u) | on %u ms | off %u ms | %lu flashes\n",
+                    ft.periodMs, ft.minPeriodMs, ft.maxPeriodMs, ft.onMs, ft.offMs,
+                    (unsigned long)ft.flashes);
+    }
+
+    // Multiplex refresh timing
+    MuxScheduler::JitterStats jit = muxScheduler.jitter();
+    Serial.println("\n--- Multiplex ---");
+    Serial.printf("Tick: min %lu ns | max %lu ns | mean %lu ns | worst dev %lu ns (%lu samples)\n",
+                  (unsigned long)jit.minNs, (unsigned long)jit.maxNs, (unsigned long)jit.meanNs,
+                  (unsigned long)jit.worstDeviationNs, (unsigned long)jit.samples);
+    muxScheduler.resetJitter();
+
     // Display status
     Serial.println("\n--- Displays ---");
     Serial.printf("Fuel OLED: %s | Temp OLED: %s | Main OLED: %s\n",
                   displaysPtr->isFuelOledConnected() ? "OK" : "N/A",
                   displaysPtr->isTempOledConnected() ? "OK" : "N/A",
                   displaysPtr->isMainOledConnected() ? "OK" : "N/A");
+
+    const Displays::RenderStats &rs = displaysPtr->renderStats();
+    Serial.printf("Render: last %lu us | max %lu us | %lu of %lu snapshots drawn\n",
+                  (unsigned long)rs.lastUs, (unsigned long)rs.maxUs,
+                  (unsigned long)rs.rendered, (unsigned long)rs.posted);
+
+    // I2C bytes actually sent vs. a full frame
+    PartialSSD1306 *oleds[] = {fuelDispPtr, tempDispPtr, mainOledPtr};
+    const char *oledNames[] = {"Fuel", "Temp", "Main"};
+    for (uint8_t i = 0; i < 3; i++)
+    {
+      if (!oleds[i])
+        continue;
+      const PartialSSD1306::TransferStats &ts = oleds[i]->stats();
+      Serial.printf("%s OLED: last %lu B (full %lu B) | %lu B in %lu frames, %lu skipped\n",
+                    oledNames[i], (unsigned long)ts.lastFrameBytes,
+                    (unsigned long)oleds[i]->fullFrameBytes(), (unsigned long)ts.totalBytes,
+                    (unsigned long)ts.frames, (unsigned long)ts.skippedFrames);
+    }
+
+    // Per-device traffic and queueing latency
+    I2CBus *buses[] = {&bus0, &bus1};
+    for (uint8_t b = 0; b < 2; b++)
+    {
+      for (uint8_t d = 0; d < buses[b]->deviceCount(); d++)
+      {
+        const I2CBus::DeviceStats &ds = buses[b]->stats(d);
+        Serial.printf("I2C%u 0x%02X: %lu B in %lu txn, %lu err | latency last %lu us, max %lu us, max wait %lu us\n",
+                      b, buses[b]->address(d), (unsigned long)ds.bytes,
+                      (unsigned long)ds.transactions, (unsigned long)ds.errors,
+                      (unsigned long)ds.lastUs, (unsigned long)ds.maxUs, (unsigned long)ds.maxWaitUs);
+      }
+    }
     Serial.println("=====================\n");
   }
 }
\ No newline at end of file
@@ -0,0 +1,134 @@
+//
+// Host stand-in for the bits of the Arduino-ESP32 core the pure-logic
+// libraries use. Time is a fake clock that only moves when a test says so.
+//
+
+#ifndef NINA_TEST_ARDUINO_H
+#define NINA_TEST_ARDUINO_H
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define PROGMEM
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define LSBFIRST 0
+#define MSBFIRST 1
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define digitalPinToInterrupt(p) (p)
+
+// ESP32 ADC1 pins → channel; everything else reads as "no ADC1"
+inline int8_t digitalPinToAnalogChannel(uint8_t pin)
+{
+    switch (pin)
+    {
+    case 36: return 0;
+    case 37: return 1;
+    case 38: return 2;
+    case 39: return 3;
+    case 32: return 4;
+    case 33: return 5;
+    case 34: return 6;
+    case 35: return 7;
+    default: return -1;
+    }
+}
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+namespace fake
+{
+    constexpr uint32_t CPU_MHZ = 240;
+
+    inline uint64_t nowNs = 0;
+
+    // Last attachInterruptArg() registration
+    inline void (*isrFn)(void *) = nullptr;
+    inline void *isrArg = nullptr;
+
+    // Output pins: current level, and a hook that sees every write
+    // (digitalWrite(), shiftOut(), GPIO.out_w1ts/w1tc)
+    constexpr uint8_t PIN_COUNT = 40;
+    inline bool pinLevel[PIN_COUNT] = {};
+    inline void (*pinHook)(uint8_t pin, bool level) = nullptr;
+
+    inline void writePin(uint8_t pin, bool level)
+    {
+        if (pin >= PIN_COUNT)
+            return;
+        pinLevel[pin] = level;
+        if (pinHook)
+            pinHook(pin, level);
+    }
+
+    inline void reset()
+    {
+        nowNs = 0;
+        isrFn = nullptr;
+        isrArg = nullptr;
+        memset(pinLevel, 0, sizeof(pinLevel));
+        pinHook = nullptr;
+    }
+
+    inline void advanceNs(uint64_t ns) { nowNs += ns; }
+    inline void advanceUs(uint64_t us) { nowNs += us * 1000; }
+    inline void advanceMs(uint64_t ms) { nowNs += ms * 1000000; }
+
+    // Fire the attached interrupt at the current fake time
+    inline void fireIsr()
+    {
+        if (isrFn)
+            isrFn(isrArg);
+    }
+}
+
+inline uint32_t micros() { return static_cast<uint32_t>(fake::nowNs / 1000); }
+inline uint32_t millis() { return static_cast<uint32_t>(fake::nowNs / 1000000); }
+
+inline void pinMode(uint8_t, uint8_t) {}
+
+inline void digitalWrite(uint8_t pin, uint8_t val) { fake::writePin(pin, val != LOW); }
+
+// Same bit order and clock sequence as the core's shiftOut()
+inline void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t val)
+{
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        bool bit = bitOrder == LSBFIRST ? (val >> i) & 1 : (val >> (7 - i)) & 1;
+        digitalWrite(dataPin, bit);
+        digitalWrite(clockPin, HIGH);
+        digitalWrite(clockPin, LOW);
+    }
+}
+
+inline void attachInterruptArg(uint8_t, void (*fn)(void *), void *arg, int)
+{
+    fake::isrFn = fn;
+    fake::isrArg = arg;
+}
+
+struct EspClass
+{
+    uint32_t getCycleCount() const
+    {
+        return static_cast<uint32_t>(fake::nowNs * fake::CPU_MHZ / 1000);
+    }
+
+    uint32_t getCpuFreqMHz() const { return fake::CPU_MHZ; }
+};
+
+inline EspClass ESP;
+
+#endif // NINA_TEST_ARDUINO_H
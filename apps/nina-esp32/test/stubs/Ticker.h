@@ -0,0 +1,41 @@
+#ifndef NINA_TEST_TICKER_H
+#define NINA_TEST_TICKER_H
+
+#pragma once
+
+#include <stdint.h>
+
+// Records the attach; tests call fire() instead of waiting
+class Ticker
+{
+public:
+    template <typename TArg>
+    void attach_ms(uint32_t ms, void (*callback)(TArg), TArg arg)
+    {
+        periodMs = ms;
+        fn = reinterpret_cast<void (*)(void *)>(callback);
+        this->arg = reinterpret_cast<void *>(arg);
+    }
+
+    void detach()
+    {
+        periodMs = 0;
+        fn = nullptr;
+    }
+
+    bool active() const { return fn != nullptr; }
+
+    void fire()
+    {
+        if (fn)
+            fn(arg);
+    }
+
+    uint32_t periodMs = 0;
+
+private:
+    void (*fn)(void *) = nullptr;
+    void *arg = nullptr;
+};
+
+#endif // NINA_TEST_TICKER_H
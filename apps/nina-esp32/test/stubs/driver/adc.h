@@ -0,0 +1,130 @@
+#ifndef NINA_TEST_ADC_H
+#define NINA_TEST_ADC_H
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <esp_err.h>
+
+// Enough of the IDF 4.4 ADC digital controller for AdcStream, with the
+// DMA replaced by a byte queue the test fills with conversion results
+// (ESP32 TYPE1 format: 12-bit data, 4-bit channel).
+#define ADC_ATTEN_DB_11 3
+#define ADC_CONV_SINGLE_UNIT_1 1
+#define ADC_DIGI_OUTPUT_FORMAT_TYPE1 0
+#define SOC_ADC_DIGI_MAX_BITWIDTH 12
+#define SOC_ADC_DIGI_RESULT_BYTES 2
+
+typedef struct
+{
+    uint32_t max_store_buf_size;
+    uint32_t conv_num_each_intr;
+    uint32_t adc1_chan_mask;
+    uint32_t adc2_chan_mask;
+} adc_digi_init_config_t;
+
+typedef struct
+{
+    uint8_t atten;
+    uint8_t channel;
+    uint8_t unit;
+    uint8_t bit_width;
+} adc_digi_pattern_config_t;
+
+typedef struct
+{
+    bool conv_limit_en;
+    uint32_t conv_limit_num;
+    uint32_t pattern_num;
+    adc_digi_pattern_config_t *adc_pattern;
+    uint32_t sample_freq_hz;
+    int conv_mode;
+    int format;
+} adc_digi_configuration_t;
+
+typedef struct
+{
+    union
+    {
+        struct
+        {
+            uint16_t data : 12;
+            uint16_t channel : 4;
+        } type1;
+        uint16_t val;
+    };
+} adc_digi_output_data_t;
+
+namespace fakeadc
+{
+    constexpr uint32_t QUEUE_BYTES = 1 << 20;
+
+    inline uint8_t queue[QUEUE_BYTES];
+    inline uint32_t head = 0;
+    inline uint32_t tail = 0;
+    inline bool overflowed = false; // next read reports a full store buffer
+    inline bool running = false;
+    inline adc_digi_configuration_t config{};
+
+    inline void reset()
+    {
+        head = tail = 0;
+        overflowed = false;
+        running = false;
+        config = {};
+    }
+
+    // One conversion result, as the DMA would store it
+    inline void push(uint8_t channel, uint16_t raw)
+    {
+        adc_digi_output_data_t d{};
+        d.type1.data = raw;
+        d.type1.channel = channel;
+        memcpy(&queue[head % QUEUE_BYTES], &d, sizeof(d));
+        head += sizeof(d);
+    }
+
+    inline uint32_t queued() { return head - tail; }
+}
+
+inline esp_err_t adc_digi_initialize(const adc_digi_init_config_t *) { return ESP_OK; }
+
+inline esp_err_t adc_digi_controller_configure(const adc_digi_configuration_t *cfg)
+{
+    fakeadc::config = *cfg;
+    return ESP_OK;
+}
+
+inline esp_err_t adc_digi_start()
+{
+    fakeadc::running = true;
+    return ESP_OK;
+}
+
+inline esp_err_t adc_digi_deinitialize()
+{
+    fakeadc::running = false;
+    return ESP_OK;
+}
+
+inline esp_err_t adc_digi_read_bytes(uint8_t *buf, uint32_t length, uint32_t *outLength, uint32_t)
+{
+    uint32_t n = fakeadc::queued() < length ? fakeadc::queued() : length;
+    *outLength = n;
+    if (n == 0)
+        return ESP_ERR_TIMEOUT;
+
+    for (uint32_t i = 0; i < n; i++)
+        buf[i] = fakeadc::queue[(fakeadc::tail + i) % fakeadc::QUEUE_BYTES];
+    fakeadc::tail += n;
+
+    if (fakeadc::overflowed)
+    {
+        fakeadc::overflowed = false;
+        return ESP_ERR_INVALID_STATE;
+    }
+    return ESP_OK;
+}
+
+#endif // NINA_TEST_ADC_H
@@ -0,0 +1,56 @@
+#ifndef NINA_TEST_PCNT_H
+#define NINA_TEST_PCNT_H
+
+#pragma once
+
+#include <stdint.h>
+#include <esp_err.h>
+
+// Enough of the legacy PCNT driver for PulseCounter to build; the ISR
+// backend is what the tests drive.
+typedef int pcnt_unit_t;
+typedef int pcnt_channel_t;
+typedef int pcnt_count_mode_t;
+typedef int pcnt_ctrl_mode_t;
+typedef int pcnt_evt_type_t;
+
+#define PCNT_UNIT_0 0
+#define PCNT_CHANNEL_0 0
+#define PCNT_PIN_NOT_USED -1
+#define PCNT_COUNT_DIS 0
+#define PCNT_COUNT_INC 1
+#define PCNT_MODE_KEEP 0
+#define PCNT_EVT_H_LIM 0x10
+
+typedef struct
+{
+    int pulse_gpio_num;
+    int ctrl_gpio_num;
+    pcnt_ctrl_mode_t lctrl_mode;
+    pcnt_ctrl_mode_t hctrl_mode;
+    pcnt_count_mode_t pos_mode;
+    pcnt_count_mode_t neg_mode;
+    int16_t counter_h_lim;
+    int16_t counter_l_lim;
+    pcnt_unit_t unit;
+    pcnt_channel_t channel;
+} pcnt_config_t;
+
+inline esp_err_t pcnt_unit_config(const pcnt_config_t *) { return ESP_OK; }
+inline esp_err_t pcnt_set_filter_value(pcnt_unit_t, uint16_t) { return ESP_OK; }
+inline esp_err_t pcnt_filter_enable(pcnt_unit_t) { return ESP_OK; }
+inline esp_err_t pcnt_filter_disable(pcnt_unit_t) { return ESP_OK; }
+inline esp_err_t pcnt_event_enable(pcnt_unit_t, pcnt_evt_type_t) { return ESP_OK; }
+inline esp_err_t pcnt_isr_service_install(int) { return ESP_OK; }
+inline esp_err_t pcnt_isr_handler_add(pcnt_unit_t, void (*)(void *), void *) { return ESP_OK; }
+inline esp_err_t pcnt_counter_pause(pcnt_unit_t) { return ESP_OK; }
+inline esp_err_t pcnt_counter_clear(pcnt_unit_t) { return ESP_OK; }
+inline esp_err_t pcnt_counter_resume(pcnt_unit_t) { return ESP_OK; }
+
+inline esp_err_t pcnt_get_counter_value(pcnt_unit_t, int16_t *count)
+{
+    *count = 0;
+    return ESP_OK;
+}
+
+#endif // NINA_TEST_PCNT_H
@@ -0,0 +1,15 @@
+#ifndef NINA_TEST_ESP_ERR_H
+#define NINA_TEST_ESP_ERR_H
+
+#pragma once
+
+typedef int esp_err_t;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERR_INVALID_STATE 0x103
+#define ESP_ERR_INVALID_SIZE 0x104
+#define ESP_ERR_TIMEOUT 0x107
+
+#endif // NINA_TEST_ESP_ERR_H
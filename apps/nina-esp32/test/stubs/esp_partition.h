@@ -0,0 +1,158 @@
+//
+// NOR flash simulator behind the esp_partition API: erase sets bytes to
+// 0xFF, programming can only clear bits, and power can be cut after any
+// number of bytes to leave a torn write or a torn erase behind.
+//
+
+#ifndef NINA_TEST_ESP_PARTITION_H
+#define NINA_TEST_ESP_PARTITION_H
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <vector>
+#include <esp_err.h>
+
+typedef enum
+{
+    ESP_PARTITION_TYPE_APP = 0x00,
+    ESP_PARTITION_TYPE_DATA = 0x01
+} esp_partition_type_t;
+
+typedef enum
+{
+    ESP_PARTITION_SUBTYPE_ANY = 0xff
+} esp_partition_subtype_t;
+
+typedef struct
+{
+    esp_partition_type_t type;
+    esp_partition_subtype_t subtype;
+    uint32_t address;
+    uint32_t size;
+    char label[17];
+} esp_partition_t;
+
+namespace flashsim
+{
+    constexpr uint32_t SECTOR = 4096;
+    constexpr uint32_t NEVER = UINT32_MAX;
+
+    inline esp_partition_t partition{ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, 0, 0, ""};
+    inline std::vector<uint8_t> cells;
+
+    // Bytes that may still be programmed/erased before the power dies
+    inline uint32_t budget = NEVER;
+    inline bool powered = true;
+
+    inline uint32_t bytesWritten = 0;
+    inline uint32_t sectorErases = 0;
+
+    // Fresh (erased) chip
+    inline void reset(const char *label, uint32_t sectors)
+    {
+        partition.size = sectors * SECTOR;
+        strncpy(partition.label, label, sizeof(partition.label) - 1);
+        cells.assign(partition.size, 0xFF);
+        budget = NEVER;
+        powered = true;
+        bytesWritten = 0;
+        sectorErases = 0;
+    }
+
+    // Power dies once `bytes` more bytes have been touched
+    inline void cutPowerAfter(uint32_t bytes)
+    {
+        budget = bytes;
+    }
+
+    // Back on, contents as the cut left them
+    inline void powerCycle()
+    {
+        budget = NEVER;
+        powered = true;
+    }
+
+    // How many of `len` bytes the operation gets to before the cut
+    inline uint32_t consume(uint32_t len)
+    {
+        if (budget == NEVER)
+            return len;
+        uint32_t done = budget < len ? budget : len;
+        budget -= done;
+        if (done < len)
+            powered = false;
+        return done;
+    }
+
+    inline bool inRange(const esp_partition_t *part, size_t offset, size_t len)
+    {
+        return part == &partition && offset + len <= partition.size;
+    }
+}
+
+inline const esp_partition_t *esp_partition_find_first(esp_partition_type_t, esp_partition_subtype_t, const char *label)
+{
+    if (flashsim::partition.size == 0 || strcmp(label, flashsim::partition.label) != 0)
+        return nullptr;
+    return &flashsim::partition;
+}
+
+inline esp_err_t esp_partition_read(const esp_partition_t *part, size_t offset, void *dst, size_t len)
+{
+    if (!flashsim::powered)
+        return ESP_FAIL;
+    if (!flashsim::inRange(part, offset, len))
+        return ESP_ERR_INVALID_SIZE;
+
+    memcpy(dst, &flashsim::cells[offset], len);
+    return ESP_OK;
+}
+
+inline esp_err_t esp_partition_write(const esp_partition_t *part, size_t offset, const void *src, size_t len)
+{
+    if (!flashsim::powered)
+        return ESP_FAIL;
+    if (!flashsim::inRange(part, offset, len))
+        return ESP_ERR_INVALID_SIZE;
+
+    const uint8_t *p = static_cast<const uint8_t *>(src);
+    uint32_t done = flashsim::consume(len);
+    for (uint32_t i = 0; i < done; i++)
+        flashsim::cells[offset + i] &= p[i];
+
+    // The byte being programmed at the cut gets only some of its bits
+    if (done < len)
+    {
+        flashsim::cells[offset + done] &= p[done] | 0xA5;
+        return ESP_FAIL;
+    }
+
+    flashsim::bytesWritten += len;
+    return ESP_OK;
+}
+
+inline esp_err_t esp_partition_erase_range(const esp_partition_t *part, size_t offset, size_t len)
+{
+    if (!flashsim::powered)
+        return ESP_FAIL;
+    if (!flashsim::inRange(part, offset, len) || offset % flashsim::SECTOR || len % flashsim::SECTOR)
+        return ESP_ERR_INVALID_ARG;
+
+    uint32_t done = flashsim::consume(len);
+    memset(&flashsim::cells[offset], 0xFF, done);
+
+    // Cells around the cut are neither old data nor erased
+    if (done < len)
+    {
+        flashsim::cells[offset + done] ^= 0x5A;
+        return ESP_FAIL;
+    }
+
+    flashsim::sectorErases += len / flashsim::SECTOR;
+    return ESP_OK;
+}
+
+#endif // NINA_TEST_ESP_PARTITION_H
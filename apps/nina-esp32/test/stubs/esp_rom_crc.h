@@ -0,0 +1,21 @@
+#ifndef NINA_TEST_ESP_ROM_CRC_H
+#define NINA_TEST_ESP_ROM_CRC_H
+
+#pragma once
+
+#include <stdint.h>
+
+// Same convention as the ROM: CRC-32 (0xEDB88320), ~ in and out
+inline uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len)
+{
+    crc = ~crc;
+    while (len--)
+    {
+        crc ^= *buf++;
+        for (int bit = 0; bit < 8; bit++)
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+#endif // NINA_TEST_ESP_ROM_CRC_H
@@ -0,0 +1,11 @@
+#ifndef NINA_TEST_ESP_TIMER_H
+#define NINA_TEST_ESP_TIMER_H
+
+#pragma once
+
+#include <Arduino.h>
+
+// Same fake clock as micros()
+inline int64_t esp_timer_get_time() { return static_cast<int64_t>(fake::nowNs / 1000); }
+
+#endif // NINA_TEST_ESP_TIMER_H
@@ -0,0 +1,45 @@
+#ifndef NINA_TEST_GPIO_STRUCT_H
+#define NINA_TEST_GPIO_STRUCT_H
+
+#pragma once
+
+#include <Arduino.h>
+
+// GPIO output set/clear registers: writing a mask drives those pins
+// through fake::writePin(), lowest GPIO first
+namespace fake
+{
+    template <bool LEVEL, uint8_t FIRST>
+    struct GpioW1
+    {
+        uint32_t val = 0;
+
+        GpioW1 &operator=(uint32_t mask)
+        {
+            val = mask;
+            for (uint8_t bit = 0; bit < 32; bit++)
+            {
+                if (mask & (1UL << bit))
+                    writePin(FIRST + bit, LEVEL);
+            }
+            return *this;
+        }
+    };
+}
+
+struct gpio_dev_t
+{
+    fake::GpioW1<true, 0> out_w1ts;
+    fake::GpioW1<false, 0> out_w1tc;
+    fake::GpioW1<true, 32> out1_w1ts;
+    fake::GpioW1<false, 32> out1_w1tc;
+    uint32_t in;
+    struct
+    {
+        uint32_t data;
+    } in1;
+};
+
+inline gpio_dev_t GPIO;
+
+#endif // NINA_TEST_GPIO_STRUCT_H
@@ -0,0 +1,174 @@
+//
+// AdcStream on a fake DMA queue: decimating 4^OS samples must resolve
+// sub-LSB levels and cut white noise by 2^OS – visible in rawNoise() vs
+// valueNoise() – however the samples are split across reads.
+//
+
+#include <unity.h>
+#include <AdcStream.h>
+#include <math.h>
+
+// HardwareConfig.h: temp on GPIO35 (ADC1 ch 7), fuel on GPIO32 (ch 4)
+static constexpr uint8_t TEMP_PIN = 35;
+static constexpr uint8_t FUEL_PIN = 32;
+static constexpr uint8_t TEMP_CH = 7;
+static constexpr uint8_t FUEL_CH = 4;
+static constexpr uint8_t OS = 4;
+static constexpr uint32_t BLOCK = 1 << (2 * OS);
+
+static uint32_t rng;
+
+static uint32_t nextRandom()
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+// Box–Muller: one standard normal sample
+static double gaussian()
+{
+    double u1 = (nextRandom() + 1.0) / 4294967297.0;
+    double u2 = nextRandom() / 4294967296.0;
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+static uint16_t noisySample(double level, double sd)
+{
+    long raw = lround(level + sd * gaussian());
+    return raw < 0 ? 0 : (raw > 4095 ? 4095 : static_cast<uint16_t>(raw));
+}
+
+// Feed both channels interleaved, as the scan pattern does, draining
+// every `chunk` pairs like loop() would
+static void feed(AdcStream &adc, uint32_t pairs, double temp, double fuel, double sd, uint32_t chunk = 600)
+{
+    for (uint32_t i = 0; i < pairs; i++)
+    {
+        fakeadc::push(TEMP_CH, noisySample(temp, sd));
+        fakeadc::push(FUEL_CH, noisySample(fuel, sd));
+        if ((i + 1) % chunk == 0)
+            adc.update();
+    }
+    while (fakeadc::queued())
+        adc.update();
+}
+
+static void start(AdcStream &adc)
+{
+    TEST_ASSERT_EQUAL_INT8(0, adc.addPin(TEMP_PIN));
+    TEST_ASSERT_EQUAL_INT8(1, adc.addPin(FUEL_PIN));
+    TEST_ASSERT_EQUAL_INT8(0, adc.addPin(TEMP_PIN)); // already scanned
+    TEST_ASSERT_TRUE(adc.begin());
+}
+
+void setUp()
+{
+    fakeadc::reset();
+    rng = 0x2545F491;
+}
+
+void tearDown()
+{
+}
+
+void test_decimation_cuts_white_noise_by_2_pow_os()
+{
+    AdcStream adc(20000, OS);
+    start(adc);
+
+    // 3 LSB SD of white noise on both inputs, 40 blocks
+    feed(adc, 40 * BLOCK, 1500.0, 2600.0, 3.0);
+
+    char msg[96];
+    for (uint8_t slot = 0; slot < 2; slot++)
+    {
+        uint16_t raw = adc.rawNoise(slot);
+        uint16_t dec = adc.valueNoise(slot);
+        snprintf(msg, sizeof(msg), "slot %u: raw SD %.2f LSB, decimated SD %.2f LSB (p-p raw %u)",
+                 slot, raw / 100.0, dec / 100.0, adc.rawSpread(slot));
+        TEST_MESSAGE(msg);
+
+        TEST_ASSERT_UINT_WITHIN_MESSAGE(40, 300, raw, msg);
+        // Expected 3 / 2^4 ≈ 0.19 LSB; 16 blocks leave the estimate rough
+        TEST_ASSERT_TRUE_MESSAGE(dec >= 10 && dec <= 30, msg);
+        TEST_ASSERT_TRUE_MESSAGE(dec * 8 < raw, msg);
+    }
+}
+
+void test_value_resolves_sub_lsb_level()
+{
+    AdcStream adc(20000, OS);
+    start(adc);
+    TEST_ASSERT_EQUAL_UINT16(4095 << OS, adc.maxValue());
+
+    // Noise dithers the quantiser: the fraction survives in the extra bits
+    feed(adc, 4 * BLOCK, 1234.37, 801.80, 2.0);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 1234.37f, adc.value(0) / 16.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 801.80f, adc.value(1) / 16.0f);
+}
+
+void test_noise_free_input_reads_zero_noise()
+{
+    AdcStream adc(20000, OS);
+    start(adc);
+    feed(adc, 20 * BLOCK, 1000.0, 3000.0, 0.0);
+
+    TEST_ASSERT_EQUAL_UINT16(1000 << OS, adc.value(0));
+    TEST_ASSERT_EQUAL_UINT16(3000 << OS, adc.value(1));
+    TEST_ASSERT_EQUAL_UINT16(0, adc.rawSpread(0));
+    TEST_ASSERT_EQUAL_UINT16(0, adc.rawNoise(0));
+    TEST_ASSERT_EQUAL_UINT16(0, adc.valueNoise(1));
+}
+
+void test_blocks_split_across_reads_and_channels()
+{
+    AdcStream adc(20000, OS);
+    start(adc);
+
+    // An unscanned channel in the stream is skipped; one value per
+    // BLOCK samples of each channel, whatever the read boundaries
+    uint32_t pairs = 10 * BLOCK + 100;
+    for (uint32_t i = 0; i < pairs; i++)
+    {
+        fakeadc::push(TEMP_CH, 100);
+        fakeadc::push(0, 4095);
+        fakeadc::push(FUEL_CH, 200);
+        if (i % 977 == 0)
+            adc.update();
+    }
+    while (fakeadc::queued())
+        adc.update();
+
+    TEST_ASSERT_EQUAL_UINT16(10, adc.sequence(0));
+    TEST_ASSERT_EQUAL_UINT16(10, adc.sequence(1));
+    TEST_ASSERT_EQUAL_UINT16(100 << OS, adc.value(0));
+    TEST_ASSERT_EQUAL_UINT16(200 << OS, adc.value(1));
+}
+
+void test_pins_and_overruns()
+{
+    AdcStream adc(20000, OS);
+    TEST_ASSERT_EQUAL_INT8(-1, adc.addPin(25)); // ADC2: blocked by WiFi
+    start(adc);
+    TEST_ASSERT_EQUAL_INT8(-1, adc.addPin(33)); // after begin()
+
+    // A full store buffer is counted, its data still used
+    fakeadc::overflowed = true;
+    feed(adc, BLOCK, 500.0, 500.0, 0.0);
+    TEST_ASSERT_EQUAL_UINT32(1, adc.overruns());
+    TEST_ASSERT_EQUAL_UINT16(1, adc.sequence(0));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_decimation_cuts_white_noise_by_2_pow_os);
+    RUN_TEST(test_value_resolves_sub_lsb_level);
+    RUN_TEST(test_noise_free_input_reads_zero_noise);
+    RUN_TEST(test_blocks_split_across_reads_and_channels);
+    RUN_TEST(test_pins_and_overruns);
+    return UNITY_END();
+}
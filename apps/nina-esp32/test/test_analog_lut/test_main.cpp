@@ -0,0 +1,142 @@
+//
+// Compile-time analog LUT against the float conversions it replaces:
+// identical at every 12-bit count, and within one step of the float
+// path for the fractional (oversampled) counts the LUT rounds away.
+//
+
+#include <unity.h>
+#include <AnalogLut.h>
+
+// HardwareConfig.h values
+static constexpr TempVPoint TEMP_V_TABLE[] = {
+    {0.35f, 20},
+    {0.55f, 40},
+    {0.80f, 60},
+    {1.05f, 80},
+    {1.30f, 100},
+    {1.50f, 110}};
+
+static constexpr AnalogSensorsConfig CONFIG{
+    12,
+    3.3f,
+    4095,
+    TEMP_V_TABLE,
+    sizeof(TEMP_V_TABLE) / sizeof(TEMP_V_TABLE[0]),
+    0,
+    120,
+    0.40f,
+    1.80f};
+
+// Built by the compiler, as in main.cpp
+static constexpr AnalogLut LUT = makeAnalogLut(CONFIG);
+
+// Independent double-precision reference for the temperature curve
+static double referenceTempC(double counts)
+{
+    double v = counts / CONFIG.adcMax * CONFIG.adcRefV;
+    const TempVPoint *t = CONFIG.tempVTable;
+    size_t n = CONFIG.tempVTableSize;
+
+    double c;
+    if (v <= t[0].vadc)
+        c = t[0].tempC;
+    else if (v >= t[n - 1].vadc)
+        c = t[n - 1].tempC;
+    else
+    {
+        size_t i = 0;
+        while (v > t[i + 1].vadc)
+            i++;
+        c = t[i].tempC + (t[i + 1].tempC - t[i].tempC) * (v - t[i].vadc) / (t[i + 1].vadc - t[i].vadc);
+    }
+    return c < CONFIG.tempMinC ? CONFIG.tempMinC : (c > CONFIG.tempMaxC ? CONFIG.tempMaxC : c);
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_lut_equals_float_path_at_every_count()
+{
+    char msg[32];
+    for (uint16_t n = 0; n <= CONFIG.adcMax; n++)
+    {
+        snprintf(msg, sizeof(msg), "count %u", n);
+
+        int16_t t = analogTempC(CONFIG, n);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(t, LUT.tempC[n], msg);
+        TEST_ASSERT_EQUAL_UINT8_MESSAGE(analogTempPercent(CONFIG, t), LUT.tempPct[n], msg);
+        TEST_ASSERT_EQUAL_UINT8_MESSAGE(analogFuelPercent(CONFIG, n), LUT.fuelPct[n], msg);
+    }
+}
+
+void test_rounding_fractional_counts_costs_at_most_one_step()
+{
+    // AnalogSensors rounds its Q4 filter output to the nearest count
+    char msg[32];
+    for (uint32_t q = 0; q <= CONFIG.adcMax * 16u; q++)
+    {
+        float counts = q / 16.0f;
+        uint16_t n = (q + 8) >> 4;
+        if (n > CONFIG.adcMax)
+            n = CONFIG.adcMax;
+        snprintf(msg, sizeof(msg), "count %.4f", counts);
+
+        TEST_ASSERT_INT_WITHIN_MESSAGE(1, analogTempC(CONFIG, counts), LUT.tempC[n], msg);
+        if (q >= 16) // below one count the float path reads "no sender"
+            TEST_ASSERT_INT_WITHIN_MESSAGE(1, analogFuelPercent(CONFIG, counts), LUT.fuelPct[n], msg);
+    }
+}
+
+void test_temperature_matches_reference_curve()
+{
+    // int truncation: at most one degree below the exact curve
+    for (uint16_t n = 0; n <= CONFIG.adcMax; n++)
+    {
+        double ref = referenceTempC(n);
+        TEST_ASSERT_TRUE(LUT.tempC[n] <= ref + 1e-3);
+        TEST_ASSERT_TRUE(LUT.tempC[n] > ref - 1.0 - 1e-3);
+    }
+}
+
+void test_curves_are_monotonic()
+{
+    for (uint16_t n = 1; n <= CONFIG.adcMax; n++)
+    {
+        TEST_ASSERT_TRUE(LUT.tempC[n] >= LUT.tempC[n - 1]);
+        TEST_ASSERT_TRUE(LUT.tempPct[n] >= LUT.tempPct[n - 1]);
+        if (n > 1)
+            TEST_ASSERT_TRUE(LUT.fuelPct[n] <= LUT.fuelPct[n - 1]); // inverted sender
+    }
+}
+
+void test_table_ends_and_fuel_range()
+{
+    // Below the first point / above the last: clamped to the table
+    TEST_ASSERT_EQUAL_INT(20, LUT.tempC[1]);
+    TEST_ASSERT_EQUAL_INT(110, LUT.tempC[CONFIG.adcMax]);
+
+    // Fuel: 0 counts = open sender, full below 0.40 V, empty above 1.80 V
+    TEST_ASSERT_EQUAL_UINT8(0, LUT.fuelPct[0]);
+    TEST_ASSERT_EQUAL_UINT8(100, LUT.fuelPct[static_cast<uint16_t>(0.35f / 3.3f * 4095)]);
+    TEST_ASSERT_EQUAL_UINT8(0, LUT.fuelPct[static_cast<uint16_t>(1.85f / 3.3f * 4095)]);
+
+    // Entries past adcMax repeat the last count
+    for (uint16_t n = CONFIG.adcMax; n < AnalogLut::SIZE; n++)
+        TEST_ASSERT_EQUAL_INT(LUT.tempC[CONFIG.adcMax], LUT.tempC[n]);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_lut_equals_float_path_at_every_count);
+    RUN_TEST(test_rounding_fractional_counts_costs_at_most_one_step);
+    RUN_TEST(test_temperature_matches_reference_curve);
+    RUN_TEST(test_curves_are_monotonic);
+    RUN_TEST(test_table_ends_and_fuel_range);
+    return UNITY_END();
+}
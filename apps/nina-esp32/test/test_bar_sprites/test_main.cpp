@@ -0,0 +1,342 @@
+//
+// Compile-time bar sprites against the Adafruit_GFX / Adafruit_SSD1306
+// drawing they replace: every frame must be byte-identical to the buffer
+// drawRoundRect, fillRect and drawBitmap leave behind, clipping included.
+// The timing test prints what a frame costs either way.
+//
+
+#include <unity.h>
+#include <BarSprites.h>
+#include <string.h>
+#include <chrono>
+
+// Displays.cpp gauge artwork
+static constexpr uint8_t image_Layer_14_bits[] = { 0xf8, 0x20, 0xf8 };
+static constexpr uint8_t image_Layer_14_1_bits[] = {
+    0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+    0xff,0xff,0xff,0x80,0x00,0x00,0x00,0x00,0x00,0x00,0x18,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x01,0x80,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x18,0x00,0x00,0x00,0x00,0x00,0x00,0x01,0x80,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x18,0x00,0x00,0x00,0x00,0x00,0x00,0x01
+  };
+static constexpr uint8_t image_Layer_15_bits[] = { 0x70, 0x88, 0x50 };
+
+static constexpr SpriteBitmap gaugeDecor[] = {
+    { 121, 29, 5, 3, image_Layer_14_bits },
+    { 4, 24, 120, 4, image_Layer_14_1_bits },
+    { 2, 29, 5, 3, image_Layer_15_bits },
+};
+
+static constexpr BarStyle gaugeStyle = {
+    1, 1, 126, 22, 3,
+    5, 4, 10, 16, 12,
+    gaugeDecor, sizeof(gaugeDecor) / sizeof(gaugeDecor[0])
+};
+
+static constexpr BarSprites<128, 32, 10> gaugeSprites = makeBarSprites<128, 32, 10>(gaugeStyle);
+
+// Reference: the library code paths the gauges used to run, SSD1306
+// buffer layout, rotation 0, colour WHITE. Virtual where the library
+// overrides, so the timing pays the same dispatch.
+template <uint8_t WIDTH, uint8_t HEIGHT>
+struct Gfx {
+    uint8_t buffer[WIDTH * ((HEIGHT + 7) / 8)] = {};
+
+    virtual ~Gfx() = default;
+
+    // Adafruit_SSD1306::drawPixel
+    virtual void drawPixel(int16_t x, int16_t y)
+    {
+        if (x >= 0 && x < WIDTH && y >= 0 && y < HEIGHT)
+            buffer[x + (y / 8) * WIDTH] |= 1 << (y & 7);
+    }
+
+    // Adafruit_SSD1306::drawFastHLineInternal
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w)
+    {
+        if (y < 0 || y >= HEIGHT)
+            return;
+        if (x < 0)
+        {
+            w += x;
+            x = 0;
+        }
+        if (x + w > WIDTH)
+            w = WIDTH - x;
+        if (w <= 0)
+            return;
+
+        uint8_t *p = &buffer[(y / 8) * WIDTH + x];
+        uint8_t mask = 1 << (y & 7);
+        while (w--)
+            *p++ |= mask;
+    }
+
+    // Adafruit_SSD1306::drawFastVLineInternal: partial first and last
+    // pages by mask, whole pages in between
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h)
+    {
+        if (x < 0 || x >= WIDTH)
+            return;
+        if (y < 0)
+        {
+            h += y;
+            y = 0;
+        }
+        if (y + h > HEIGHT)
+            h = HEIGHT - y;
+        if (h <= 0)
+            return;
+
+        static const uint8_t premask[8] = {0x00, 0x80, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC, 0xFE};
+        static const uint8_t postmask[8] = {0x00, 0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F};
+
+        uint8_t *p = &buffer[(y / 8) * WIDTH + x];
+        uint8_t mod = y & 7;
+        if (mod)
+        {
+            mod = 8 - mod;
+            uint8_t mask = premask[mod];
+            if (h < mod)
+                mask &= 0xFF >> (mod - h);
+            *p |= mask;
+            if (h < mod)
+                return;
+            h -= mod;
+            p += WIDTH;
+        }
+        while (h >= 8)
+        {
+            *p = 0xFF;
+            p += WIDTH;
+            h -= 8;
+        }
+        if (h)
+            *p |= postmask[h];
+    }
+
+    // Adafruit_GFX::fillRect
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+        for (int16_t i = x; i < x + w; i++)
+            drawFastVLine(i, y, h);
+    }
+
+    // Adafruit_GFX::drawCircleHelper
+    void drawCircleHelper(int16_t x0, int16_t y0, int16_t r, uint8_t corner)
+    {
+        int16_t f = 1 - r;
+        int16_t ddF_x = 1;
+        int16_t ddF_y = -2 * r;
+        int16_t x = 0;
+        int16_t y = r;
+
+        while (x < y)
+        {
+            if (f >= 0)
+            {
+                y--;
+                ddF_y += 2;
+                f += ddF_y;
+            }
+            x++;
+            ddF_x += 2;
+            f += ddF_x;
+            if (corner & 0x4)
+            {
+                drawPixel(x0 + x, y0 + y);
+                drawPixel(x0 + y, y0 + x);
+            }
+            if (corner & 0x2)
+            {
+                drawPixel(x0 + x, y0 - y);
+                drawPixel(x0 + y, y0 - x);
+            }
+            if (corner & 0x8)
+            {
+                drawPixel(x0 - y, y0 + x);
+                drawPixel(x0 - x, y0 + y);
+            }
+            if (corner & 0x1)
+            {
+                drawPixel(x0 - y, y0 - x);
+                drawPixel(x0 - x, y0 - y);
+            }
+        }
+    }
+
+    // Adafruit_GFX::drawRoundRect
+    void drawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r)
+    {
+        int16_t max_radius = ((w < h) ? w : h) / 2;
+        if (r > max_radius)
+            r = max_radius;
+        drawFastHLine(x + r, y, w - 2 * r);
+        drawFastHLine(x + r, y + h - 1, w - 2 * r);
+        drawFastVLine(x, y + r, h - 2 * r);
+        drawFastVLine(x + w - 1, y + r, h - 2 * r);
+        drawCircleHelper(x + r, y + r, r, 1);
+        drawCircleHelper(x + w - r - 1, y + r, r, 2);
+        drawCircleHelper(x + w - r - 1, y + h - r - 1, r, 4);
+        drawCircleHelper(x + r, y + h - r - 1, r, 8);
+    }
+
+    // Adafruit_GFX::drawBitmap, transparent background
+    void drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h)
+    {
+        int16_t byteWidth = (w + 7) / 8;
+        uint8_t b = 0;
+        for (int16_t j = 0; j < h; j++, y++)
+        {
+            for (int16_t i = 0; i < w; i++)
+            {
+                if (i & 7)
+                    b <<= 1;
+                else
+                    b = bitmap[j * byteWidth + i / 8];
+                if (b & 0x80)
+                    drawPixel(x + i, y);
+            }
+        }
+    }
+
+    // What Displays drew before the sprites
+    void drawBar(const BarStyle &s, uint8_t lit)
+    {
+        memset(buffer, 0, sizeof(buffer));
+        drawRoundRect(s.frameX, s.frameY, s.frameW, s.frameH, s.frameR);
+        for (uint8_t i = 0; i < lit; i++)
+            fillRect(s.segX + s.segPitch * i, s.segY, s.segW, s.segH);
+        for (uint8_t d = 0; d < s.decorCount; d++)
+        {
+            const SpriteBitmap &b = s.decor[d];
+            drawBitmap(b.x, b.y, b.bits, b.w, b.h);
+        }
+    }
+};
+
+template <uint8_t WIDTH, uint8_t HEIGHT, uint8_t SEGMENTS>
+static void checkAllFrames(const BarSprites<WIDTH, HEIGHT, SEGMENTS> &sheet, const BarStyle &style)
+{
+    static Gfx<WIDTH, HEIGHT> gfx;
+    char msg[32];
+    for (uint8_t lit = 0; lit <= SEGMENTS; lit++)
+    {
+        gfx.drawBar(style, lit);
+        snprintf(msg, sizeof(msg), "%u segments lit", lit);
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(gfx.buffer, sheet[lit], sizeof(gfx.buffer), msg);
+    }
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_gauge_frames_equal_gfx_for_every_percent()
+{
+    // Displays: bars = pct * 10 / 100
+    static Gfx<128, 32> gfx;
+    char msg[32];
+    for (uint8_t pct = 0; pct <= 100; pct++)
+    {
+        uint8_t lit = pct * 10 / 100;
+        gfx.drawBar(gaugeStyle, lit);
+        snprintf(msg, sizeof(msg), "%u %%", pct);
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(gfx.buffer, gaugeSprites[lit], sizeof(gfx.buffer), msg);
+    }
+}
+
+void test_out_of_range_value_shows_full_bar()
+{
+    TEST_ASSERT_EQUAL_PTR(gaugeSprites.frame[10], gaugeSprites[11]);
+    TEST_ASSERT_EQUAL_PTR(gaugeSprites.frame[10], gaugeSprites[255]);
+}
+
+// Shapes hanging off every edge, partial pages, bitmap wider than a byte
+static constexpr uint8_t arrowBits[] = {0x18, 0x00, 0x3C, 0x00, 0x7E, 0x00, 0xFF, 0x80, 0x18, 0x00};
+
+static constexpr SpriteBitmap clippedDecor[] = {
+    { -3, 17, 9, 5, arrowBits },
+    { 60, -2, 9, 5, arrowBits },
+    { 59, 18, 9, 5, arrowBits },
+};
+
+static constexpr BarStyle clippedStyle = {
+    -2, 3, 70, 15, 6,
+    -4, 5, 7, 13, 9,
+    clippedDecor, sizeof(clippedDecor) / sizeof(clippedDecor[0])
+};
+
+static constexpr BarSprites<64, 20, 8> clippedSprites = makeBarSprites<64, 20, 8>(clippedStyle);
+
+void test_clipping_and_partial_pages_equal_gfx()
+{
+    checkAllFrames(clippedSprites, clippedStyle);
+}
+
+// Radius above half the short side: clamped like drawRoundRect
+static constexpr BarStyle pillStyle = {
+    0, 0, 40, 9, 20,
+    3, 2, 2, 5, 4,
+    nullptr, 0
+};
+
+static constexpr BarSprites<40, 9, 9> pillSprites = makeBarSprites<40, 9, 9>(pillStyle);
+
+void test_oversized_radius_equal_gfx()
+{
+    checkAllFrames(pillSprites, pillStyle);
+}
+
+// Mean ns per call of fn(i) over n calls
+template <typename Fn>
+static double nsPerCall(uint32_t n, Fn fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; i++)
+        fn(i);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / n;
+}
+
+void test_sprite_render_time_against_gfx()
+{
+    // drawBar() as before (GFX, every call) and now (one memcpy), over
+    // every percentage in turn
+    constexpr uint32_t FRAMES = 200000;
+    static Gfx<128, 32> gfx;
+    static uint8_t buffer[sizeof(gfx.buffer)];
+    uint8_t *volatile dst = buffer; // keep the copies observable
+    volatile uint8_t sink = 0;
+
+    double gfxNs = nsPerCall(FRAMES, [&](uint32_t i) {
+        gfx.drawBar(gaugeStyle, (i % 101) * 10 / 100);
+        sink = sink + gfx.buffer[i & 511];
+    });
+    double spriteNs = nsPerCall(FRAMES, [&](uint32_t i) {
+        memcpy(dst, gaugeSprites[(i % 101) * 10 / 100], sizeof(buffer));
+        sink = sink + dst[i & 511];
+    });
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "GFX drawBar %.0f ns/frame, sprite memcpy %.0f ns/frame (%.0fx)",
+             gfxNs, spriteNs, gfxNs / spriteNs);
+    TEST_MESSAGE(msg);
+
+    TEST_ASSERT_TRUE(spriteNs < gfxNs);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_gauge_frames_equal_gfx_for_every_percent);
+    RUN_TEST(test_out_of_range_value_shows_full_bar);
+    RUN_TEST(test_clipping_and_partial_pages_equal_gfx);
+    RUN_TEST(test_oversized_radius_equal_gfx);
+    RUN_TEST(test_sprite_render_time_against_gfx);
+    return UNITY_END();
+}
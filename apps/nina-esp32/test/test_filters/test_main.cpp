@@ -0,0 +1,258 @@
+//
+// Fixed-point filter stages against float references: the EMA must
+// track alpha = dt / (tau + dt) whatever the call rate and settle on
+// the input exactly; the median must drop glitches, the slew limit hold its
+// rate and the hysteresis its band. The timing test prints what one
+// step of each stage and of the shipped chains costs.
+//
+
+#include <unity.h>
+#include <Filters.h>
+#include <math.h>
+#include <chrono>
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_median_drops_short_glitches()
+{
+    MedianFilter<5> f;
+    TEST_ASSERT_EQUAL_INT32(100, f.step(100, 0));
+
+    // Up to two consecutive outliers in a window of five vanish
+    int32_t input[] = {100, 4000, 100, 100, -3000, -3000, 100, 100, 100};
+    for (int32_t x : input)
+        TEST_ASSERT_EQUAL_INT32(100, f.step(x, 0));
+
+    // A real step passes after three samples
+    TEST_ASSERT_EQUAL_INT32(100, f.step(200, 0));
+    TEST_ASSERT_EQUAL_INT32(100, f.step(200, 0));
+    TEST_ASSERT_EQUAL_INT32(200, f.step(200, 0));
+}
+
+// Float EMA with the same dt-aware alpha
+static float emaReference(float y, float x, float dtUs, float tauUs)
+{
+    return y + (x - y) * dtUs / (tauUs + dtUs);
+}
+
+template <uint32_t TAU_MS>
+static void checkStepResponse(const uint32_t *dts, size_t count, uint32_t durationUs)
+{
+    EmaFilter<TAU_MS> f;
+    f.step(0, 0);
+
+    const int32_t target = 16000; // counts × 16, full scale
+    float ref = 0.0f;
+    uint32_t t = 0;
+    size_t i = 0;
+    char msg[48];
+
+    while (t < durationUs)
+    {
+        uint32_t dt = dts[i++ % count];
+        t += dt;
+        int32_t y = f.step(target, dt);
+        ref = emaReference(ref, target, dt, TAU_MS * 1000.0f);
+
+        // Batching of tiny steps lags by at most tau/256 worth of input
+        snprintf(msg, sizeof(msg), "tau %u ms, t %u us", static_cast<unsigned>(TAU_MS), static_cast<unsigned>(t));
+        TEST_ASSERT_INT_WITHIN_MESSAGE(target / 200 + 1, ref, y, msg);
+    }
+}
+
+void test_ema_tracks_float_reference_at_any_rate()
+{
+    const uint32_t fast[] = {1000};
+    const uint32_t slow[] = {50000};
+    const uint32_t jittery[] = {700, 3100, 12000, 250, 40000, 5000, 1};
+
+    checkStepResponse<30>(fast, 1, 300000);
+    checkStepResponse<30>(jittery, 7, 300000);
+    checkStepResponse<1000>(fast, 1, 5000000);
+    checkStepResponse<1000>(slow, 1, 5000000);
+    checkStepResponse<1000>(jittery, 7, 5000000);
+    checkStepResponse<4000>(jittery, 7, 20000000);
+}
+
+void test_ema_time_constant_independent_of_call_rate()
+{
+    // After one tau every rate should read ~63 % (1 - 1/e), within the
+    // discretisation of alpha = dt / (tau + dt)
+    const uint32_t rates[] = {500, 1000, 10000, 50000};
+    for (uint32_t dt : rates)
+    {
+        EmaFilter<500> f;
+        f.step(0, 0);
+        int32_t y = 0;
+        for (uint32_t t = 0; t < 500000; t += dt)
+            y = f.step(10000, dt);
+
+        TEST_ASSERT_INT_WITHIN(450, 6321, y);
+    }
+}
+
+void test_ema_settles_exactly_with_tiny_alpha()
+{
+    // tau 4 s at 1 ms: alpha ≈ 1/4000 – a plain Q16 filter stalls short
+    EmaFilter<4000> f;
+    f.step(0, 0);
+    int32_t y = 0;
+    for (uint32_t i = 0; i < 60000; i++)
+        y = f.step(37, 1000);
+    TEST_ASSERT_EQUAL_INT32(37, y);
+
+    for (uint32_t i = 0; i < 60000; i++)
+        y = f.step(-5, 1000);
+    TEST_ASSERT_EQUAL_INT32(-5, y);
+}
+
+void test_ema_long_gap_jumps_most_of_the_way()
+{
+    // dt ≫ tau: alpha → 1 without overflowing the Q16 maths
+    EmaFilter<30> f;
+    f.step(0, 0);
+    int32_t y = f.step(1000000, 10000000);
+    TEST_ASSERT_INT_WITHIN(5000, 1000000, y);
+}
+
+void test_slew_limit_holds_rate()
+{
+    SlewLimitFilter<100> f; // 100 units per second
+    f.step(0, 0);
+
+    int32_t y = 0;
+    for (uint32_t t = 0; t < 1000000; t += 10000)
+        y = f.step(1000, 10000);
+    TEST_ASSERT_INT_WITHIN(1, 100, y);
+
+    // Sub-unit steps: credit accumulates, no rate lost to rounding
+    SlewLimitFilter<100> g;
+    g.step(0, 0);
+    for (uint32_t t = 0; t < 1000000; t += 1000)
+        y = g.step(1000, 1000);
+    TEST_ASSERT_INT_WITHIN(1, 100, y);
+
+    // Caught up: no banked credit for the next jump
+    for (uint32_t t = 0; t < 2000000; t += 10000)
+        g.step(150, 10000);
+    TEST_ASSERT_EQUAL_INT32(150, g.step(150, 10000));
+    TEST_ASSERT_INT_WITHIN(1, 151, g.step(10000, 10000));
+}
+
+void test_hysteresis_band()
+{
+    HysteresisFilter<8> f;
+    TEST_ASSERT_EQUAL_INT32(100, f.step(100, 0));
+
+    for (int32_t d = -7; d <= 7; d++)
+        TEST_ASSERT_EQUAL_INT32(100, f.step(100 + d, 0));
+
+    TEST_ASSERT_EQUAL_INT32(108, f.step(108, 0));
+    TEST_ASSERT_EQUAL_INT32(108, f.step(101, 0));
+    TEST_ASSERT_EQUAL_INT32(100, f.step(100, 0));
+}
+
+void test_chain_runs_stages_in_order_and_resets()
+{
+    // Median first: the spike never reaches the EMA
+    FilterChain<MedianFilter<3>, EmaFilter<100>, HysteresisFilter<4>> chain;
+    chain.reset(500);
+
+    TEST_ASSERT_EQUAL_INT32(500, chain.step(500, 10000));
+    TEST_ASSERT_EQUAL_INT32(500, chain.step(90000, 10000));
+    TEST_ASSERT_EQUAL_INT32(500, chain.step(500, 10000));
+
+    // Reset primes every stage: no settling from the old value
+    chain.reset(2000);
+    TEST_ASSERT_EQUAL_INT32(2000, chain.step(2000, 10000));
+}
+
+// The chains as AnalogSensors.h and SpeedInput.h declare them
+using TempChain = FilterChain<MedianFilter<5>, EmaFilter<1000>, HysteresisFilter<(4 << 4)>>;
+using FuelChain = FilterChain<MedianFilter<5>, EmaFilter<4000>, HysteresisFilter<(4 << 4)>>;
+using SpeedChain = FilterChain<EmaFilter<30>, SlewLimitFilter<10000>>;
+
+// Noisy ADC-like input (counts × 16) and jittery loop spacing, made up
+// front so the timing is the filter alone
+static constexpr uint32_t BENCH_INPUTS = 4096;
+static int32_t benchX[BENCH_INPUTS];
+static uint32_t benchDt[BENCH_INPUTS];
+
+static void makeBenchInput()
+{
+    uint32_t rng = 12345;
+    for (uint32_t i = 0; i < BENCH_INPUTS; i++)
+    {
+        rng = rng * 1664525u + 1013904223u;
+        benchX[i] = 32000 + static_cast<int32_t>((rng >> 16) & 0x3FF) - 512;
+        benchDt[i] = 800 + ((rng >> 8) & 0x7FF);
+    }
+}
+
+// Mean ns per step() over n steps
+template <typename F>
+static double nsPerStep(uint32_t n)
+{
+    F f;
+    f.reset(benchX[0]);
+    volatile int32_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        uint32_t k = i & (BENCH_INPUTS - 1);
+        sink = sink + f.step(benchX[k], benchDt[k]);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / n;
+}
+
+void test_step_cost()
+{
+    constexpr uint32_t STEPS = 2000000;
+    makeBenchInput();
+
+    struct Result
+    {
+        const char *name;
+        double ns;
+    };
+    const Result results[] = {
+        {"MedianFilter<5>", nsPerStep<MedianFilter<5>>(STEPS)},
+        {"EmaFilter<1000>", nsPerStep<EmaFilter<1000>>(STEPS)},
+        {"SlewLimitFilter<10000>", nsPerStep<SlewLimitFilter<10000>>(STEPS)},
+        {"HysteresisFilter<64>", nsPerStep<HysteresisFilter<64>>(STEPS)},
+        {"AnalogSensors temp chain", nsPerStep<TempChain>(STEPS)},
+        {"AnalogSensors fuel chain", nsPerStep<FuelChain>(STEPS)},
+        {"SpeedInput chain", nsPerStep<SpeedChain>(STEPS)},
+    };
+
+    char msg[64];
+    for (const Result &r : results)
+    {
+        snprintf(msg, sizeof(msg), "%-26s %6.1f ns/step", r.name, r.ns);
+        TEST_MESSAGE(msg);
+        TEST_ASSERT_TRUE(r.ns > 0.0);
+    }
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_median_drops_short_glitches);
+    RUN_TEST(test_ema_tracks_float_reference_at_any_rate);
+    RUN_TEST(test_ema_time_constant_independent_of_call_rate);
+    RUN_TEST(test_ema_settles_exactly_with_tiny_alpha);
+    RUN_TEST(test_ema_long_gap_jumps_most_of_the_way);
+    RUN_TEST(test_slew_limit_holds_rate);
+    RUN_TEST(test_hysteresis_band);
+    RUN_TEST(test_chain_runs_stages_in_order_and_resets);
+    RUN_TEST(test_step_cost);
+    return UNITY_END();
+}
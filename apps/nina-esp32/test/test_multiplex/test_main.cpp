@@ -0,0 +1,291 @@
+//
+// Multiplex transports on fake pins: whatever the backend, the chain must
+// see the last register first, MSB first, and latch once after the last
+// clock – the bit stream of the original shiftOut() loop.
+//
+
+#include <unity.h>
+#include <Multiplex.h>
+#include <ParallelShift.h>
+
+// 74HC595 chain on fake pins: samples data on rising SRCLK, copies the
+// shift register to the outputs on rising RCLK
+struct Chain595
+{
+    uint8_t dataPin, clockPin, latchPin, regs;
+    uint8_t shift[4]{};
+    uint8_t out[4]{};
+    uint8_t stream[64]{}; // data level at each clock edge since the last latch
+    uint8_t streamBits = 0;
+    uint8_t latches = 0;
+
+    void pin(uint8_t pin, bool level, bool wasHigh)
+    {
+        if (pin == clockPin && level && !wasHigh)
+        {
+            bool bit = fake::pinLevel[dataPin];
+            // Q7' of each register feeds the next one down the chain
+            for (int8_t r = regs - 1; r > 0; r--)
+                shift[r] = (shift[r] << 1) | (shift[r - 1] >> 7);
+            shift[0] = (shift[0] << 1) | bit;
+            if (streamBits < sizeof(stream))
+                stream[streamBits++] = bit;
+        }
+        else if (pin == latchPin && level && !wasHigh)
+        {
+            memcpy(out, shift, sizeof(out));
+            latches++;
+        }
+    }
+
+    // Stream since the last latch, 8 bits per byte, MSB = first bit out
+    uint8_t streamByte(uint8_t n) const
+    {
+        uint8_t b = 0;
+        for (uint8_t i = 0; i < 8; i++)
+            b = (b << 1) | stream[n * 8 + i];
+        return b;
+    }
+
+    void clearStream()
+    {
+        streamBits = 0;
+    }
+};
+
+static Chain595 *chains[4];
+static uint8_t chainCount = 0;
+static bool lastLevel[fake::PIN_COUNT];
+
+static void onPin(uint8_t pin, bool level)
+{
+    for (uint8_t i = 0; i < chainCount; i++)
+        chains[i]->pin(pin, level, lastLevel[pin]);
+    lastLevel[pin] = level;
+}
+
+static void attach(Chain595 &c)
+{
+    chains[chainCount++] = &c;
+}
+
+// Captures what Multiplex hands its transport
+struct RecordingTransport : MultiplexTransport
+{
+    uint8_t last[8]{};
+    uint8_t lastCount = 0;
+    uint32_t writes = 0;
+
+    void begin() override {}
+
+    void write(const uint8_t *regs, uint8_t numRegs) override
+    {
+        memcpy(last, regs, numRegs);
+        lastCount = numRegs;
+        writes++;
+    }
+};
+
+void setUp()
+{
+    fake::reset();
+    fake::pinHook = onPin;
+    memset(lastLevel, 0, sizeof(lastLevel));
+    chainCount = 0;
+}
+
+void tearDown()
+{
+}
+
+void test_flush_hands_transport_whole_image()
+{
+    RecordingTransport rec;
+    Multiplex<3> mux(2, 3, 4, 1, 1000);
+    mux.setTransport(rec);
+    mux.begin();
+    TEST_ASSERT_EQUAL_UINT32(1, rec.writes); // cleared image on begin()
+
+    uint8_t *regs = mux.registers();
+    regs[0] = 0x01;
+    regs[1] = 0x80;
+    regs[2] = 0xA5;
+    mux.flush();
+
+    TEST_ASSERT_EQUAL_UINT8(3, rec.lastCount);
+    TEST_ASSERT_EQUAL_HEX8(0x01, rec.last[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x80, rec.last[1]);
+    TEST_ASSERT_EQUAL_HEX8(0xA5, rec.last[2]);
+    TEST_ASSERT_FALSE(mux.isrSafe()); // virtual path only
+}
+
+void test_bitbang_flush_last_register_first_msb_first()
+{
+    Chain595 chain{2, 3, 4, 3};
+    attach(chain);
+
+    Multiplex<3> mux(2, 3, 4, 1, 1000); // default bit-bang transport
+    mux.begin();
+    chain.clearStream();
+
+    uint8_t *regs = mux.registers();
+    regs[0] = 0x01;
+    regs[1] = 0x80;
+    regs[2] = 0xA5;
+    mux.flush();
+
+    TEST_ASSERT_EQUAL_UINT8(24, chain.streamBits);
+    TEST_ASSERT_EQUAL_HEX8(0xA5, chain.streamByte(0));
+    TEST_ASSERT_EQUAL_HEX8(0x80, chain.streamByte(1));
+    TEST_ASSERT_EQUAL_HEX8(0x01, chain.streamByte(2));
+
+    // regs[0] ends up in the register nearest the data input
+    TEST_ASSERT_EQUAL_UINT8(2, chain.latches);
+    TEST_ASSERT_EQUAL_HEX8(0x01, chain.out[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x80, chain.out[1]);
+    TEST_ASSERT_EQUAL_HEX8(0xA5, chain.out[2]);
+}
+
+void test_frame_cache_tick_sends_published_image()
+{
+    RecordingTransport rec;
+    Multiplex<2> mux(2, 3, 4, 1, 1000);
+    mux.setTransport(rec);
+    mux.begin();
+    mux.enableFrameCache();
+
+    mux.backFrame(0)[0] = 0x0F;
+    mux.backFrame(0)[1] = 0xC3;
+    mux.publish();
+
+    // Full brightness: every plane shows the image
+    for (uint8_t i = 0; i < 16; i++)
+        mux.tick();
+
+    TEST_ASSERT_EQUAL_UINT8(2, rec.lastCount);
+    TEST_ASSERT_EQUAL_HEX8(0x0F, rec.last[0]);
+    TEST_ASSERT_EQUAL_HEX8(0xC3, rec.last[1]);
+
+    // Unchanged planes are not re-shifted
+    uint32_t writes = rec.writes;
+    for (uint8_t i = 0; i < 16; i++)
+        mux.tick();
+    TEST_ASSERT_EQUAL_UINT32(writes, rec.writes);
+
+    // Live gate drops an output without a publish()
+    mux.setLive(0, 0, 0x00, 0x01);
+    mux.tick();
+    TEST_ASSERT_EQUAL_HEX8(0x0E, rec.last[0]);
+}
+
+// Clock 5, a 2-register lane on 12/13 and a 1-register lane on 14/15
+using Lane2 = ShiftLane<12, 13, 2>;
+using Lane1 = ShiftLane<14, 15, 1>;
+using Group = ParallelShift<5, Lane2, Lane1>;
+
+void test_parallel_lanes_stage_last_register_first_msb_first()
+{
+    Chain595 longChain{12, 5, 13, 2};
+    Chain595 shortChain{14, 5, 15, 1};
+    attach(longChain);
+    attach(shortChain);
+
+    Group group(1000);
+    TEST_ASSERT_TRUE(group.lane(0).isrSafe());
+
+    const uint8_t longRegs[2] = {0x3C, 0x81};
+    const uint8_t shortRegs[1] = {0x5A};
+    group.lane(0).send(longRegs, 2);
+    group.lane(1).send(shortRegs, 1);
+    group.tick(); // no members: just shift the staged lanes
+
+    // One shared clock: both lanes see the longest chain's 16 edges
+    TEST_ASSERT_EQUAL_UINT8(16, longChain.streamBits);
+    TEST_ASSERT_EQUAL_UINT8(16, shortChain.streamBits);
+
+    TEST_ASSERT_EQUAL_HEX8(0x81, longChain.streamByte(0));
+    TEST_ASSERT_EQUAL_HEX8(0x3C, longChain.streamByte(1));
+
+    // The shorter chain's byte rides at the end of the stream
+    TEST_ASSERT_EQUAL_HEX8(0x5A, shortChain.streamByte(1));
+
+    TEST_ASSERT_EQUAL_UINT8(1, longChain.latches);
+    TEST_ASSERT_EQUAL_UINT8(1, shortChain.latches);
+    TEST_ASSERT_EQUAL_HEX8(0x3C, longChain.out[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x81, longChain.out[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x5A, shortChain.out[0]);
+}
+
+void test_parallel_lane_only_latches_when_staged()
+{
+    Chain595 longChain{12, 5, 13, 2};
+    Chain595 shortChain{14, 5, 15, 1};
+    attach(longChain);
+    attach(shortChain);
+
+    Group group(1000);
+    const uint8_t shortRegs[1] = {0xF0};
+    group.lane(1).send(shortRegs, 1);
+    group.tick();
+
+    TEST_ASSERT_EQUAL_UINT8(0, longChain.latches);
+    TEST_ASSERT_EQUAL_UINT8(1, shortChain.latches);
+    TEST_ASSERT_EQUAL_HEX8(0xF0, shortChain.out[0]);
+
+    // Nothing staged: no clock edges at all
+    shortChain.clearStream();
+    group.tick();
+    TEST_ASSERT_EQUAL_UINT8(0, shortChain.streamBits);
+}
+
+void test_multiplex_through_parallel_lane()
+{
+    Chain595 longChain{12, 5, 13, 2};
+    attach(longChain);
+
+    Group group(1000);
+    Multiplex<2> mux(12, 5, 13, 1, 1000);
+    mux.setTransport(group.lane(0));
+    TEST_ASSERT_TRUE(mux.isrSafe());
+    TEST_ASSERT_TRUE(group.add(mux));
+
+    // The group's tick runs the member's tick, which stages the plane
+    mux.enableFrameCache();
+    mux.backFrame(0)[0] = 0x12;
+    mux.backFrame(0)[1] = 0x34;
+    mux.publish();
+    for (uint8_t i = 0; i < 16; i++)
+        group.tick();
+
+    TEST_ASSERT_EQUAL_HEX8(0x12, longChain.out[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x34, longChain.out[1]);
+}
+
+void test_ticker_fallback_refuses_sub_ms_refresh()
+{
+    // Bit-bang isn't ISR-safe, so these chains land on Ticker
+    Multiplex<2> fast(2, 3, 4, 3, 250);
+    TEST_ASSERT_FALSE(fast.isrSafe());
+    TEST_ASSERT_FALSE(fast.start());
+
+    Multiplex<2> slow(2, 3, 4, 3, 2000);
+    TEST_ASSERT_TRUE(slow.start());
+    slow.stop();
+
+    // A scheduled chain never needs the Ticker
+    fast.setScheduled(true);
+    TEST_ASSERT_TRUE(fast.start());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_flush_hands_transport_whole_image);
+    RUN_TEST(test_bitbang_flush_last_register_first_msb_first);
+    RUN_TEST(test_frame_cache_tick_sends_published_image);
+    RUN_TEST(test_parallel_lanes_stage_last_register_first_msb_first);
+    RUN_TEST(test_parallel_lane_only_latches_when_staged);
+    RUN_TEST(test_multiplex_through_parallel_lane);
+    RUN_TEST(test_ticker_fallback_refuses_sub_ms_refresh);
+    return UNITY_END();
+}
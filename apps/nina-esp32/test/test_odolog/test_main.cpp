@@ -0,0 +1,202 @@
+//
+// OdoLog against the NOR flash simulator: the power is cut after every
+// possible byte of a record write and of a sector erase, and each time a
+// reboot must restore either the previous or the new record – never
+// garbage, never nothing – and keep logging afterwards.
+//
+
+#include <unity.h>
+#include <OdoLog.h>
+
+static constexpr const char *LABEL = "odolog";
+static constexpr uint32_t SECTORS = 4;
+static constexpr uint32_t RECORD = 32;
+static constexpr uint32_t RECORDS_PER_SECTOR = flashsim::SECTOR / RECORD;
+
+static const OdoLog::Policy POLICY = {1000, 10UL * 60 * 1000, 30UL * 1000};
+
+static OdoLog::State stateFor(uint32_t n)
+{
+    // Every field moves, so a mix-up between two records is visible
+    return {100000 + n * 7, n * 7, n * 60, static_cast<uint8_t>(n % 101)};
+}
+
+static void assertState(const OdoLog::State &expected, const OdoLog::State &actual, const char *msg)
+{
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(expected.odoMeters, actual.odoMeters, msg);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(expected.tripMeters, actual.tripMeters, msg);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(expected.runSeconds, actual.runSeconds, msg);
+    TEST_ASSERT_EQUAL_UINT8_MESSAGE(expected.fuelPct, actual.fuelPct, msg);
+}
+
+// Log holding records 1..count (count commits on a fresh chip)
+static void fillLog(uint32_t count)
+{
+    OdoLog log(LABEL, POLICY);
+    TEST_ASSERT_TRUE(log.begin());
+    for (uint32_t n = 1; n <= count; n++)
+        TEST_ASSERT_TRUE(log.commitNow(stateFor(n), n));
+}
+
+static bool rebootAndRestore(OdoLog::State &out)
+{
+    OdoLog log(LABEL, POLICY);
+    return log.begin() && log.restore(out);
+}
+
+// Cut the power at every byte of the next append (erase + write or
+// write only), then reboot twice: once to check the restore, once
+// more after logging another record on the damaged chip.
+static void powerLossSweep(uint32_t committed, uint32_t appendBytes)
+{
+    fillLog(committed);
+    const std::vector<uint8_t> image = flashsim::cells;
+
+    const OdoLog::State before = stateFor(committed);
+    const OdoLog::State torn = stateFor(committed + 1);
+    const OdoLog::State after = stateFor(committed + 2);
+
+    char msg[48];
+    for (uint32_t cut = 0; cut <= appendBytes; cut++)
+    {
+        snprintf(msg, sizeof(msg), "power cut after %u bytes", static_cast<unsigned>(cut));
+
+        flashsim::cells = image;
+        flashsim::powerCycle();
+
+        OdoLog log(LABEL, POLICY);
+        TEST_ASSERT_TRUE_MESSAGE(log.begin(), msg);
+        flashsim::cutPowerAfter(cut);
+        bool ok = log.commitNow(torn, 0);
+        TEST_ASSERT_EQUAL_MESSAGE(cut == appendBytes, ok, msg);
+        flashsim::powerCycle();
+
+        OdoLog::State restored{};
+        TEST_ASSERT_TRUE_MESSAGE(rebootAndRestore(restored), msg);
+        assertState(cut < appendBytes ? before : torn, restored, msg);
+
+        OdoLog next(LABEL, POLICY);
+        TEST_ASSERT_TRUE_MESSAGE(next.begin(), msg);
+        TEST_ASSERT_TRUE_MESSAGE(next.commitNow(after, 0), msg);
+
+        TEST_ASSERT_TRUE_MESSAGE(rebootAndRestore(restored), msg);
+        assertState(after, restored, msg);
+    }
+}
+
+void setUp()
+{
+    flashsim::reset(LABEL, SECTORS);
+}
+
+void tearDown()
+{
+}
+
+void test_missing_partition_fails_begin()
+{
+    OdoLog log("nope", POLICY);
+    TEST_ASSERT_FALSE(log.begin());
+    TEST_ASSERT_FALSE(log.commitNow(stateFor(1), 0));
+}
+
+void test_blank_log_restores_nothing()
+{
+    OdoLog::State out{};
+    OdoLog log(LABEL, POLICY);
+    TEST_ASSERT_TRUE(log.begin());
+    TEST_ASSERT_FALSE(log.restore(out));
+}
+
+void test_restores_newest_across_wrap()
+{
+    // Two and a half passes over every sector
+    const uint32_t count = SECTORS * RECORDS_PER_SECTOR * 5 / 2;
+    fillLog(count);
+
+    OdoLog::State out{};
+    TEST_ASSERT_TRUE(rebootAndRestore(out));
+    assertState(stateFor(count), out, "newest record");
+    TEST_ASSERT_EQUAL_UINT32(count * RECORD, flashsim::bytesWritten);
+}
+
+void test_never_erases_newest_sector()
+{
+    // Sector 0 full: the next record starts sector 1 and erases only it
+    fillLog(RECORDS_PER_SECTOR);
+    uint32_t erases = flashsim::sectorErases;
+
+    OdoLog log(LABEL, POLICY);
+    TEST_ASSERT_TRUE(log.begin());
+    TEST_ASSERT_TRUE(log.commitNow(stateFor(RECORDS_PER_SECTOR + 1), 0));
+    TEST_ASSERT_EQUAL_UINT32(erases + 1, flashsim::sectorErases);
+
+    OdoLog::State out{};
+    TEST_ASSERT_TRUE(log.restore(out));
+    assertState(stateFor(RECORDS_PER_SECTOR + 1), out, "after sector change");
+}
+
+void test_power_loss_during_record_write()
+{
+    // Mid-sector: the append is a single 32-byte program
+    powerLossSweep(5, RECORD);
+}
+
+void test_power_loss_during_sector_erase()
+{
+    // Every sector full once: the next append erases the oldest sector
+    // (full of valid records) before writing into it
+    powerLossSweep(SECTORS * RECORDS_PER_SECTOR, flashsim::SECTOR + RECORD);
+}
+
+void test_run_time_and_fuel_alone_do_not_commit()
+{
+    OdoLog log(LABEL, POLICY);
+    TEST_ASSERT_TRUE(log.begin());
+    TEST_ASSERT_TRUE(log.commitNow({5000, 50, 100, 80}, 0));
+
+    // Parked for an hour: run time and fuel change, distance doesn't
+    for (uint32_t s = 1; s <= 3600; s++)
+        log.maybeCommit({5000, 50, 100 + s, static_cast<uint8_t>(80 - s % 3)}, s * 1000);
+
+    TEST_ASSERT_EQUAL_UINT32(1, log.commits());
+
+    // Power-down commit still saves them
+    TEST_ASSERT_TRUE(log.commitNow({5000, 50, 3700, 79}, 3600 * 1000));
+    OdoLog::State out{};
+    TEST_ASSERT_TRUE(rebootAndRestore(out));
+    assertState({5000, 50, 3700, 79}, out, "final record");
+}
+
+void test_commit_policy_distance_and_intervals()
+{
+    OdoLog log(LABEL, POLICY);
+    TEST_ASSERT_TRUE(log.begin());
+    TEST_ASSERT_TRUE(log.commitNow({0, 0, 0, 50}, 0));
+
+    // A full commit distance, but inside the minimum interval
+    TEST_ASSERT_FALSE(log.maybeCommit({1000, 1000, 10, 50}, 10 * 1000));
+    TEST_ASSERT_TRUE(log.maybeCommit({1000, 1000, 30, 50}, 30 * 1000));
+
+    // Crawling: less than commitMeters waits for maxIntervalMs
+    uint32_t t = 30 * 1000;
+    TEST_ASSERT_FALSE(log.maybeCommit({1100, 1100, 100, 50}, t + 60 * 1000));
+    TEST_ASSERT_FALSE(log.maybeCommit({1200, 1200, 500, 50}, t + 9 * 60 * 1000));
+    TEST_ASSERT_TRUE(log.maybeCommit({1300, 1300, 630, 50}, t + 10 * 60 * 1000));
+
+    TEST_ASSERT_EQUAL_UINT32(3, log.commits());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_missing_partition_fails_begin);
+    RUN_TEST(test_blank_log_restores_nothing);
+    RUN_TEST(test_restores_newest_across_wrap);
+    RUN_TEST(test_never_erases_newest_sector);
+    RUN_TEST(test_power_loss_during_record_write);
+    RUN_TEST(test_power_loss_during_sector_erase);
+    RUN_TEST(test_run_time_and_fuel_alone_do_not_commit);
+    RUN_TEST(test_commit_policy_distance_and_intervals);
+    return UNITY_END();
+}
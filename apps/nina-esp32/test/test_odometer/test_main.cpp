@@ -0,0 +1,118 @@
+//
+// Odometer replayed with known pulse counts: distance must come out
+// exact to the pulse, however the pulses are split across loop passes.
+//
+
+#include <unity.h>
+#include <Odometer.h>
+
+// HALL_UM_PER_PULSE: 3200 pulses per mile = 502 920 µm
+static constexpr uint32_t PULSES_PER_MILE = 3200;
+static constexpr uint32_t UM_PER_PULSE = 1609344000UL / PULSES_PER_MILE;
+
+static uint32_t expectedMeters(uint64_t pulses)
+{
+    return static_cast<uint32_t>(pulses * UM_PER_PULSE / 1000000);
+}
+
+// Small LCG: repeatable pulse batches of varying size
+static uint32_t nextRandom(uint32_t &state)
+{
+    state = state * 1664525u + 1013904223u;
+    return state >> 16;
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_first_update_sets_baseline()
+{
+    Odometer odo(UM_PER_PULSE);
+    odo.update(123456);
+    TEST_ASSERT_EQUAL_UINT32(0, odo.totalMeters());
+
+    odo.update(123456 + PULSES_PER_MILE);
+    TEST_ASSERT_EQUAL_UINT32(1609, odo.totalMeters());
+}
+
+void test_known_count_exact_for_any_batching()
+{
+    // 1000 miles, fed in random batches of 0..63 pulses per pass
+    const uint32_t total = 1000 * PULSES_PER_MILE;
+    Odometer odo(UM_PER_PULSE);
+    uint32_t counter = 0;
+    uint32_t rng = 1;
+    odo.update(counter);
+
+    while (counter < total)
+    {
+        uint32_t step = nextRandom(rng) & 63;
+        if (counter + step > total)
+            step = total - counter;
+        counter += step;
+        odo.update(counter);
+
+        TEST_ASSERT_EQUAL_UINT32(expectedMeters(counter), odo.totalMeters());
+    }
+
+    // 1000 miles = 1 609 344 m exactly
+    TEST_ASSERT_EQUAL_UINT32(1609344, odo.totalMeters());
+    TEST_ASSERT_EQUAL_UINT32(1609344, odo.tripMeters());
+}
+
+void test_single_pulses_match_one_batch()
+{
+    Odometer single(UM_PER_PULSE);
+    Odometer batch(UM_PER_PULSE);
+
+    for (uint32_t i = 0; i < 12345; i++)
+        single.addPulses(1);
+    batch.addPulses(12345);
+
+    TEST_ASSERT_EQUAL_UINT32(batch.totalMeters(), single.totalMeters());
+    TEST_ASSERT_EQUAL_UINT32(expectedMeters(12345), single.totalMeters());
+}
+
+void test_counter_wrap()
+{
+    Odometer odo(UM_PER_PULSE);
+    uint32_t counter = 0xFFFFFFFFu - 1000;
+    odo.update(counter);
+
+    counter += 2 * PULSES_PER_MILE; // wraps past zero
+    odo.update(counter);
+    TEST_ASSERT_EQUAL_UINT32(3218, odo.totalMeters());
+}
+
+void test_trip_reset_and_restore()
+{
+    Odometer odo(UM_PER_PULSE);
+    odo.restore(250000, 120);
+    odo.update(0);
+    odo.update(PULSES_PER_MILE);
+
+    TEST_ASSERT_EQUAL_UINT32(250000 + 1609, odo.totalMeters());
+    TEST_ASSERT_EQUAL_UINT32(120 + 1609, odo.tripMeters());
+
+    // Trip restarts from zero, total keeps its sub-metre remainder
+    odo.resetTrip();
+    odo.update(2 * PULSES_PER_MILE);
+    TEST_ASSERT_EQUAL_UINT32(1609, odo.tripMeters());
+    TEST_ASSERT_EQUAL_UINT32(250000 + 3218, odo.totalMeters());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_first_update_sets_baseline);
+    RUN_TEST(test_known_count_exact_for_any_batching);
+    RUN_TEST(test_single_pulses_match_one_batch);
+    RUN_TEST(test_counter_wrap);
+    RUN_TEST(test_trip_reset_and_restore);
+    return UNITY_END();
+}
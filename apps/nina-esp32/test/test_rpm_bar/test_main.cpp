@@ -0,0 +1,85 @@
+//
+// Compile-time RPM bar table: the last entry is the full bar for every
+// curve, the bar never shrinks as rpm rises, and the progressive curve
+// holds up at the top of the uint16_t range.
+//
+
+#include <unity.h>
+#include <RPM.h>
+
+static uint8_t litLeds(const uint8_t regs[RPMMeter::CHANNELS])
+{
+    uint8_t n = 0;
+    for (uint8_t reg = 0; reg < RPMMeter::CHANNELS; reg++)
+    {
+        for (uint8_t v = regs[reg]; v; v >>= 1)
+            n += v & 1;
+    }
+    return n;
+}
+
+template <uint16_t ENTRIES>
+static void checkTable(const RpmBarLut<ENTRIES> &lut, uint16_t maxRpm)
+{
+    TEST_ASSERT_EQUAL_UINT32(maxRpm, uint32_t(lut.stepRpm) * (ENTRIES - 1));
+    TEST_ASSERT_EQUAL_UINT8(0, litLeds(lut.regs[0]));
+    TEST_ASSERT_EQUAL_UINT8(RPMMeter::TOTAL_LEDS, litLeds(lut.regs[ENTRIES - 1]));
+
+    for (uint16_t i = 1; i < ENTRIES; i++)
+        TEST_ASSERT_TRUE(litLeds(lut.regs[i]) >= litLeds(lut.regs[i - 1]));
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_shipped_config_fills_the_bar()
+{
+    // HardwareConfig.h: 8000 rpm in 50 rpm steps, redline 6000 on 5 LEDs
+    constexpr auto linear = makeRpmBarLut<8000, 50>(RpmBarCurve::Linear);
+    constexpr auto progressive = makeRpmBarLut<8000, 50>(RpmBarCurve::Progressive);
+    constexpr auto redline = makeRpmBarLut<8000, 50>(RpmBarCurve::Redline, 6000, 5);
+
+    checkTable(linear, 8000);
+    checkTable(progressive, 8000);
+    checkTable(redline, 8000);
+
+    // Redline: the first 24 LEDs are full exactly at 6000 rpm
+    TEST_ASSERT_EQUAL_UINT8(24, litLeds(redline.regs[6000 / 50]));
+    TEST_ASSERT_EQUAL_UINT8(23, litLeds(redline.regs[6000 / 50 - 1]));
+}
+
+void test_progressive_at_uint16_max_does_not_overflow()
+{
+    // 29 × 65000² needs more than 32 bits
+    constexpr auto lut = makeRpmBarLut<65000, 1000>(RpmBarCurve::Progressive);
+    checkTable(lut, 65000);
+
+    // 32 000 rpm: 29 × (32/65)² = 7.03 LEDs
+    TEST_ASSERT_EQUAL_UINT8(7, litLeds(lut.regs[32]));
+}
+
+void test_lsb_first_register_layout()
+{
+    // 10 of 29 LEDs: register 0 full, register 1 bits 0–1
+    constexpr auto lut = makeRpmBarLut<2900, 100>(RpmBarCurve::Linear);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, lut.regs[10][0]);
+    TEST_ASSERT_EQUAL_HEX8(0x03, lut.regs[10][1]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, lut.regs[10][2]);
+
+    // Register 3 drives only 5 LEDs
+    TEST_ASSERT_EQUAL_HEX8(0x1F, lut.regs[29][3]);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_shipped_config_fills_the_bar);
+    RUN_TEST(test_progressive_at_uint16_max_does_not_overflow);
+    RUN_TEST(test_lsb_first_register_layout);
+    return UNITY_END();
+}
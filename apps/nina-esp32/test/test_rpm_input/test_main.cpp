@@ -0,0 +1,224 @@
+//
+// RPMInput (ISR backend, Period mode) fed synthetic ignition pulse
+// trains through the fake clock: the edge ISR stamps with the cycle
+// counter, update() runs on a 1 ms loop.
+//
+
+#include <unity.h>
+#include <RPMInput.h>
+
+static constexpr uint8_t PIN = 34;
+static constexpr uint8_t PPR = 2;
+static constexpr uint16_t STOP_MS = 500;
+static constexpr uint16_t MAX_RPM = 12000;
+static constexpr uint64_t LOOP_NS = 1000000;
+
+static uint64_t periodNs(float rpm)
+{
+    return static_cast<uint64_t>(60.0e9 / (rpm * PPR));
+}
+
+// Ignition pulses into the edge ISR, update() on a 1 ms loop. The
+// pulse phase carries over between run() calls, so speed changes and
+// stray edges land inside a continuous train.
+struct Train
+{
+    static constexpr uint64_t NONE = UINT64_MAX;
+
+    RPMInput &in;
+    uint64_t nextPulse = NONE;
+    uint64_t nextLoop = NONE;
+    uint64_t nextEcho = NONE;
+    uint64_t echoNs = 0; // extra edge this long after every pulse
+    uint64_t stray = NONE;
+
+    explicit Train(RPMInput &in) : in(in) {}
+
+    // One extra edge `afterNs` from now
+    void strayIn(uint64_t afterNs) { stray = fake::nowNs + afterNs; }
+
+    void run(uint64_t pulseNs, uint64_t durationNs)
+    {
+        if (nextPulse == NONE)
+        {
+            nextPulse = fake::nowNs + pulseNs;
+            nextLoop = fake::nowNs + LOOP_NS;
+        }
+
+        const uint64_t end = fake::nowNs + durationNs;
+        while (true)
+        {
+            uint64_t next = nextLoop;
+            if (nextPulse < next)
+                next = nextPulse;
+            if (nextEcho < next)
+                next = nextEcho;
+            if (stray < next)
+                next = stray;
+            if (next > end)
+                break;
+
+            fake::nowNs = next;
+            if (next == nextPulse)
+            {
+                fake::fireIsr();
+                nextPulse += pulseNs;
+                if (echoNs)
+                    nextEcho = next + echoNs;
+            }
+            else if (next == nextEcho)
+            {
+                fake::fireIsr();
+                nextEcho = NONE;
+            }
+            else if (next == stray)
+            {
+                fake::fireIsr();
+                stray = NONE;
+            }
+            else
+            {
+                in.update();
+                nextLoop += LOOP_NS;
+            }
+        }
+        fake::nowNs = end;
+    }
+};
+
+static void beginInput(RPMInput &in)
+{
+    fake::advanceMs(10); // cycle counter away from zero
+    in.begin();
+}
+
+void setUp()
+{
+    fake::reset();
+}
+
+void tearDown()
+{
+}
+
+void test_steady_trains_500_to_9000_rpm()
+{
+    char msg[48];
+    for (uint16_t rpm = 500; rpm <= 9000; rpm += 250)
+    {
+        snprintf(msg, sizeof(msg), "%u rpm", rpm);
+
+        RPMInput in(PIN, 200, PPR, RPMInput::Mode::Period, PPR, STOP_MS, MAX_RPM);
+        beginInput(in);
+        Train(in).run(periodNs(rpm), 1000 * LOOP_NS);
+
+        // Exact: cycle-counter resolution, well under 0.1 %
+        TEST_ASSERT_FLOAT_WITHIN_MESSAGE(rpm * 0.001f, rpm, in.rpmExact(), msg);
+        // Smoothed: settled after 1 s of a 30 ms time constant
+        TEST_ASSERT_UINT_WITHIN_MESSAGE(rpm / 200 + 1, rpm, in.rpm(), msg);
+    }
+}
+
+void test_first_value_after_one_revolution()
+{
+    RPMInput in(PIN, 200, PPR, RPMInput::Mode::Period, PPR, STOP_MS, MAX_RPM);
+    beginInput(in);
+
+    // Three pulses = two periods = one revolution at 2 ppr
+    Train(in).run(periodNs(3000), periodNs(3000) * 3 + LOOP_NS);
+    TEST_ASSERT_FLOAT_WITHIN(3.0f, 3000, in.rpmExact());
+}
+
+void test_speed_steps_settle_within_100ms()
+{
+    RPMInput in(PIN, 200, PPR, RPMInput::Mode::Period, PPR, STOP_MS, MAX_RPM);
+    beginInput(in);
+
+    // 1000 → 9000 rpm and back in 500 rpm steps of 100 ms. A step over
+    // the ±25 % median window costs one extra period, nothing more.
+    Train train(in);
+    train.run(periodNs(1000), 200 * LOOP_NS);
+    for (int16_t step = 0; step <= 32; step++)
+    {
+        uint16_t rpm = 1000 + 500 * (step <= 16 ? step : 32 - step);
+        train.run(periodNs(rpm), 100 * LOOP_NS);
+        TEST_ASSERT_FLOAT_WITHIN(rpm * 0.01f, rpm, in.rpmExact());
+    }
+}
+
+void test_ringing_faster_than_max_rpm_is_ignored()
+{
+    RPMInput in(PIN, 200, PPR, RPMInput::Mode::Period, PPR, STOP_MS, MAX_RPM);
+    beginInput(in);
+
+    // A second edge 200 µs after every real pulse (≫ 12000 rpm)
+    Train train(in);
+    train.echoNs = 200000;
+    train.run(periodNs(4000), 500 * LOOP_NS);
+    TEST_ASSERT_FLOAT_WITHIN(4.0f, 4000, in.rpmExact());
+}
+
+void test_stray_pulse_rejected_by_median_window()
+{
+    RPMInput in(PIN, 200, PPR, RPMInput::Mode::Period, 8, STOP_MS, MAX_RPM);
+    beginInput(in);
+    Train train(in);
+    const uint64_t p = periodNs(2000);
+    train.run(p, 300 * LOOP_NS);
+
+    // One stray spark mid-period (slow enough to pass the ISR filter)
+    // splits a period in two; neither half may move the reading
+    train.strayIn(train.nextPulse - fake::nowNs - p / 2);
+    for (uint8_t i = 0; i < 30; i++)
+    {
+        train.run(p, LOOP_NS);
+        TEST_ASSERT_FLOAT_WITHIN(20.0f, 2000, in.rpmExact());
+    }
+}
+
+void test_deceleration_follows_open_period()
+{
+    RPMInput in(PIN, 200, PPR, RPMInput::Mode::Period, PPR, STOP_MS, MAX_RPM);
+    beginInput(in);
+    Train(in).run(periodNs(3000), 300 * LOOP_NS);
+
+    // Pulses stop: the open period bounds the reading from above
+    for (uint8_t ms = 0; ms < 100; ms++)
+    {
+        fake::advanceNs(LOOP_NS);
+        in.update();
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(60000.0f / (100 * PPR) + 1, in.rpmExact());
+}
+
+void test_stop_timeout_reads_zero()
+{
+    RPMInput in(PIN, 200, PPR, RPMInput::Mode::Period, PPR, STOP_MS, MAX_RPM);
+    beginInput(in);
+    Train(in).run(periodNs(800), 500 * LOOP_NS);
+
+    for (uint16_t ms = 0; ms <= STOP_MS + 200; ms++)
+    {
+        fake::advanceNs(LOOP_NS);
+        in.update();
+    }
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, in.rpmExact());
+    TEST_ASSERT_EQUAL_UINT16(0, in.rpm());
+
+    // Restart: the stopped gap must not count as a period
+    Train(in).run(periodNs(800), 300 * LOOP_NS);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 800, in.rpmExact());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_steady_trains_500_to_9000_rpm);
+    RUN_TEST(test_first_value_after_one_revolution);
+    RUN_TEST(test_speed_steps_settle_within_100ms);
+    RUN_TEST(test_ringing_faster_than_max_rpm_is_ignored);
+    RUN_TEST(test_stray_pulse_rejected_by_median_window);
+    RUN_TEST(test_deceleration_follows_open_period);
+    RUN_TEST(test_stop_timeout_reads_zero);
+    return UNITY_END();
+}
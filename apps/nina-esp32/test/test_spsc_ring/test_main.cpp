@@ -0,0 +1,150 @@
+//
+// SpscRing under a real producer thread and consumer thread: every
+// accepted event arrives exactly once, in order and untorn, and every
+// rejected one is counted.
+//
+
+#include <unity.h>
+#include <SpscRing.h>
+#include <thread>
+
+// Multi-word payload: a torn slot read shows up as a bad check word
+struct Event
+{
+    uint32_t seq;
+    uint32_t stamp;
+    uint32_t check;
+};
+
+static Event makeEvent(uint32_t seq)
+{
+    return {seq, seq * 2654435761u, ~seq ^ 0x5A5A5A5A};
+}
+
+static bool intact(const Event &e)
+{
+    return e.stamp == e.seq * 2654435761u && e.check == (~e.seq ^ 0x5A5A5A5A);
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_fill_drain_and_drop_count()
+{
+    SpscRing<uint32_t, 8> ring;
+    for (uint32_t i = 0; i < 8; i++)
+        TEST_ASSERT_TRUE(ring.push(i));
+
+    // Full: the new event is dropped, nothing already queued is touched
+    TEST_ASSERT_FALSE(ring.push(99));
+    TEST_ASSERT_EQUAL_UINT32(1, ring.dropped());
+    TEST_ASSERT_EQUAL_UINT32(8, ring.size());
+
+    uint32_t v;
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        TEST_ASSERT_TRUE(ring.pop(v));
+        TEST_ASSERT_EQUAL_UINT32(i, v);
+    }
+    TEST_ASSERT_FALSE(ring.pop(v));
+    TEST_ASSERT_TRUE(ring.empty());
+    TEST_ASSERT_EQUAL_UINT32(8, ring.pushed());
+}
+
+// Producer retries until accepted: all events must come through
+void test_stress_no_event_lost()
+{
+    static SpscRing<Event, 64> ring;
+    constexpr uint32_t COUNT = 200000;
+
+    uint32_t rejected = 0;
+    std::thread producer([&] {
+        for (uint32_t seq = 0; seq < COUNT; seq++)
+        {
+            while (!ring.push(makeEvent(seq)))
+            {
+                rejected++;
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    uint32_t torn = 0;
+    uint32_t outOfOrder = 0;
+    Event e;
+    while (expected < COUNT)
+    {
+        if (!ring.pop(e))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        if (!intact(e))
+            torn++;
+        if (e.seq != expected)
+            outOfOrder++;
+        expected = e.seq + 1;
+    }
+    producer.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+    TEST_ASSERT_EQUAL_UINT32(0, outOfOrder);
+    TEST_ASSERT_FALSE(ring.pop(e));
+    TEST_ASSERT_EQUAL_UINT32(COUNT, ring.pushed());
+    TEST_ASSERT_EQUAL_UINT32(rejected, ring.dropped());
+}
+
+// ISR-style producer never waits; a slow consumer loses only what the
+// drop counter reports
+void test_stress_drops_are_accounted()
+{
+    static SpscRing<Event, 16> ring;
+    constexpr uint32_t COUNT = 200000;
+
+    std::thread producer([&] {
+        for (uint32_t seq = 0; seq < COUNT; seq++)
+            ring.push(makeEvent(seq));
+    });
+
+    uint32_t received = 0;
+    uint32_t torn = 0;
+    uint32_t backwards = 0;
+    int64_t last = -1;
+    Event e;
+    bool done = false;
+    while (!done)
+    {
+        done = ring.pushed() + ring.dropped() == COUNT && ring.empty();
+        while (ring.pop(e))
+        {
+            received++;
+            if (!intact(e))
+                torn++;
+            if (static_cast<int64_t>(e.seq) <= last)
+                backwards++;
+            last = e.seq;
+        }
+        std::this_thread::yield();
+    }
+    producer.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+    TEST_ASSERT_EQUAL_UINT32(0, backwards);
+    TEST_ASSERT_EQUAL_UINT32(COUNT, received + ring.dropped());
+    TEST_ASSERT_EQUAL_UINT32(received, ring.pushed());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_fill_drain_and_drop_count);
+    RUN_TEST(test_stress_no_event_lost);
+    RUN_TEST(test_stress_drops_are_accounted);
+    return UNITY_END();
+}
@@ -0,0 +1,227 @@
+//
+// VerticalDebounce replayed with bouncy switch edges: one debounced
+// flip per real transition, none for glitches, and every bit behaving
+// exactly like its own scalar 4-sample debouncer.
+//
+
+#include <unity.h>
+#include <VerticalDebounce.h>
+
+static constexpr uint32_t SAMPLE_US = 5000; // DIGITAL_SAMPLE_MS
+static constexpr uint32_t BOUNCE_US = 2000; // contact bounce after an edge
+
+// Reference: one channel, counter restarts on any agreeing sample
+struct ScalarDebounce
+{
+    bool state = false;
+    uint8_t count = 0;
+
+    bool sample(bool raw)
+    {
+        if (raw == state)
+        {
+            count = 0;
+            return false;
+        }
+        if (++count < 4)
+            return false;
+        state = raw;
+        count = 0;
+        return true;
+    }
+};
+
+static uint32_t nextRandom(uint32_t &state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// Contact with bounce: for BOUNCE_US after each edge the level chatters
+struct BouncySwitch
+{
+    bool level = false;
+    uint32_t edgeUs = 0;
+    uint32_t rng;
+
+    explicit BouncySwitch(uint32_t seed) : rng(seed) {}
+
+    void set(bool on, uint32_t nowUs)
+    {
+        level = on;
+        edgeUs = nowUs;
+    }
+
+    bool read(uint32_t nowUs)
+    {
+        if (nowUs - edgeUs < BOUNCE_US)
+            return nextRandom(rng) & 1;
+        return level;
+    }
+};
+
+template <typename Mask>
+static void checkAgainstScalar(uint32_t seed)
+{
+    constexpr uint8_t BITS = sizeof(Mask) * 8;
+    VerticalDebounce<Mask> vd;
+    ScalarDebounce ref[BITS];
+    vd.reset(0);
+
+    uint32_t rng = seed;
+    Mask raw = 0;
+    for (uint32_t n = 0; n < 200000; n++)
+    {
+        // Per-bit flip chance 1/8–4/8 per sample: runs both shorter and
+        // longer than the 4-sample threshold
+        uint32_t r = nextRandom(rng);
+        Mask flip = 0;
+        for (uint8_t b = 0; b < BITS; b++)
+        {
+            if ((nextRandom(rng) & 7) < (r & 3) + 1)
+                flip |= static_cast<Mask>(1) << b;
+        }
+        raw ^= flip;
+
+        Mask toggled = vd.sample(raw);
+        for (uint8_t b = 0; b < BITS; b++)
+        {
+            bool t = ref[b].sample((raw >> b) & 1);
+            if (t != (((toggled >> b) & 1) != 0) || ref[b].state != (((vd.value() >> b) & 1) != 0))
+            {
+                char msg[48];
+                snprintf(msg, sizeof(msg), "bit %u, sample %u", b, static_cast<unsigned>(n));
+                TEST_FAIL_MESSAGE(msg);
+            }
+        }
+    }
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_every_bit_matches_scalar_debouncer_8()
+{
+    checkAgainstScalar<uint8_t>(0x12345678);
+}
+
+void test_every_bit_matches_scalar_debouncer_32()
+{
+    checkAgainstScalar<uint32_t>(0x9E3779B9);
+}
+
+void test_bouncy_edges_flip_once_with_bounded_latency()
+{
+    // 7 inputs, each toggled at its own random times, with bounce
+    constexpr uint8_t INPUTS = 7;
+    VerticalDebounce<uint8_t> vd;
+    vd.reset(0);
+
+    BouncySwitch sw[INPUTS] = {
+        BouncySwitch(11), BouncySwitch(22), BouncySwitch(33), BouncySwitch(44),
+        BouncySwitch(55), BouncySwitch(66), BouncySwitch(77)};
+    uint32_t nextEdge[INPUTS];
+    uint32_t transitions[INPUTS]{};
+    uint32_t flips[INPUTS]{};
+    uint32_t rng = 2024;
+
+    for (uint8_t i = 0; i < INPUTS; i++)
+        nextEdge[i] = 50000 + nextRandom(rng) % 300000;
+
+    // 60 s; no new edges in the last 100 ms so every one can settle
+    constexpr uint32_t END_US = 60000000;
+    char msg[48];
+    for (uint32_t now = 0; now < END_US; now += SAMPLE_US)
+    {
+        // Switch edges land anywhere between two samples
+        for (uint8_t i = 0; i < INPUTS; i++)
+        {
+            if (now >= nextEdge[i] && nextEdge[i] < END_US - 100000)
+            {
+                sw[i].set(!sw[i].level, nextEdge[i]);
+                transitions[i]++;
+                // Held at least 40 ms, as any real switch or relay is
+                nextEdge[i] += 40000 + nextRandom(rng) % 400000;
+            }
+        }
+
+        uint8_t raw = 0;
+        for (uint8_t i = 0; i < INPUTS; i++)
+            raw |= sw[i].read(now) << i;
+
+        uint8_t toggled = vd.sample(raw);
+        for (uint8_t i = 0; i < INPUTS; i++)
+        {
+            if (!(toggled & (1 << i)))
+                continue;
+
+            flips[i]++;
+            snprintf(msg, sizeof(msg), "input %u flip %u", i, static_cast<unsigned>(flips[i]));
+
+            // Right level, no earlier than 3 samples after the edge and no
+            // later than 4 samples after the bounce has died out
+            TEST_ASSERT_EQUAL_MESSAGE(sw[i].level, (vd.value() >> i) & 1, msg);
+            uint32_t latency = now - sw[i].edgeUs;
+            TEST_ASSERT_TRUE_MESSAGE(latency >= 3 * SAMPLE_US, msg);
+            TEST_ASSERT_TRUE_MESSAGE(latency <= BOUNCE_US + 4 * SAMPLE_US, msg);
+        }
+    }
+
+    for (uint8_t i = 0; i < INPUTS; i++)
+    {
+        snprintf(msg, sizeof(msg), "input %u", i);
+        TEST_ASSERT_GREATER_THAN(100, transitions[i]);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(transitions[i], flips[i], msg);
+    }
+}
+
+void test_glitches_shorter_than_four_samples_never_flip()
+{
+    VerticalDebounce<uint8_t> vd;
+    vd.reset(0x0F);
+
+    for (uint8_t len = 1; len <= 3; len++)
+    {
+        for (uint8_t i = 0; i < len; i++)
+            TEST_ASSERT_EQUAL_HEX8(0, vd.sample(0xF0));
+        TEST_ASSERT_EQUAL_HEX8(0, vd.sample(0x0F));
+        TEST_ASSERT_EQUAL_HEX8(0x0F, vd.value());
+    }
+
+    // Four in a row is a real change, on every bit at once
+    for (uint8_t i = 0; i < 3; i++)
+        TEST_ASSERT_EQUAL_HEX8(0, vd.sample(0xF0));
+    TEST_ASSERT_EQUAL_HEX8(0xFF, vd.sample(0xF0));
+    TEST_ASSERT_EQUAL_HEX8(0xF0, vd.value());
+}
+
+void test_reset_clears_pending_counts()
+{
+    VerticalDebounce<uint8_t> vd;
+    vd.reset(0);
+    vd.sample(0x01);
+    vd.sample(0x01);
+    vd.sample(0x01);
+
+    vd.reset(0);
+    TEST_ASSERT_EQUAL_HEX8(0, vd.sample(0x01));
+    TEST_ASSERT_EQUAL_HEX8(0, vd.value());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_every_bit_matches_scalar_debouncer_8);
+    RUN_TEST(test_every_bit_matches_scalar_debouncer_32);
+    RUN_TEST(test_bouncy_edges_flip_once_with_bounded_latency);
+    RUN_TEST(test_glitches_shorter_than_four_samples_never_flip);
+    RUN_TEST(test_reset_clears_pending_counts);
+    return UNITY_END();
+}
@@ -5,36 +5,54 @@ ButtonInput::ButtonInput(uint8_t p, ButtonId i, bool al)
 {
 }
 
+void IRAM_ATTR ButtonInput::isr(void *arg)
+{
+	ButtonInput *self = static_cast<ButtonInput *>(arg);
+	self->events.push({micros(), digitalRead(self->pin) == HIGH});
+}
+
 void ButtonInput::begin()
 {
 	pinMode(pin, INPUT_PULLUP); // Use internal pull-up (works for both active-low and active-high)
 	lastState = activeLow ? !digitalRead(pin) : digitalRead(pin);
 	currentState = lastState;
-	lastDebounceTime = millis();
+	lastEdgeUs = micros();
+
+	attachInterruptArg(pin, isr, this, CHANGE);
 }
 
 void ButtonInput::update()
 {
-	bool reading = digitalRead(pin);
-	if (activeLow)
+	// Replay the edges the ISR saw, in order
+	Edge edge;
+	while (events.pop(edge))
 	{
-		reading = !reading; // Invert if active-low
-	}
+		bool reading = activeLow ? !edge.level : edge.level;
 
-	unsigned long now = millis();
+		// Debounce logic
+		if (reading != lastState)
+		{
+			lastState = reading;
+			lastEdgeUs = edge.us;
+		}
+	}
 
-	// Debounce logic
-	if (reading != lastState)
+	// Lost edges: resync from the pin and restart the debounce window
+	uint32_t drops = events.dropped();
+	if (drops != seenDrops)
 	{
-		lastDebounceTime = now;
+		seenDrops = drops;
+		bool reading = digitalRead(pin);
+		lastState = activeLow ? !reading : reading;
+		lastEdgeUs = micros();
 	}
 
 	// If debounce delay has passed, update state
-	if ((now - lastDebounceTime) > DEBOUNCE_DELAY_MS)
+	if ((micros() - lastEdgeUs) > DEBOUNCE_DELAY_MS * 1000)
 	{
-		if (reading != currentState)
+		if (lastState != currentState)
 		{
-			currentState = reading;
+			currentState = lastState;
 			if (currentState)
 			{
 				// Button just pressed (rising edge)
@@ -42,8 +60,6 @@ void ButtonInput::update()
 			}
 		}
 	}
-
-	lastState = reading;
 }
 
 bool ButtonInput::isPressed() const
@@ -60,4 +76,3 @@ bool ButtonInput::wasPressed()
 	}
 	return false;
 }
-
@@ -1,5 +1,6 @@
 #pragma once
 #include <Arduino.h>
+#include <SpscRing.h>
 
 class ButtonInput
 {
@@ -19,7 +20,19 @@ public:
 	bool wasPressed(); // Returns true once per press (edge detection)
 	ButtonId getId() const { return id; }
 
+	// Edges lost to a full event ring (bounce storm while loop stalled)
+	uint32_t droppedEdges() const { return events.dropped(); }
+
 private:
+	// One entry per pin change, stamped in the ISR
+	struct Edge
+	{
+		uint32_t us;
+		bool level;
+	};
+
+	static void IRAM_ATTR isr(void *arg);
+
 	uint8_t pin;
 	ButtonId id;
 	bool activeLow;
@@ -27,7 +40,9 @@ private:
 	bool currentState = false;
 	bool pressedFlag = false; // Edge detection flag
 
-	unsigned long lastDebounceTime = 0;
+	SpscRing<Edge, 32> events;
+	uint32_t seenDrops = 0;
+
+	uint32_t lastEdgeUs = 0; // debounce runs on ISR timestamps
 	static constexpr unsigned long DEBOUNCE_DELAY_MS = 50;
 };
-
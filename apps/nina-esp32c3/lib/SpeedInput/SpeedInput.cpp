@@ -1,14 +1,12 @@
 #include "SpeedInput.h"
 
 // ======================
-// ISR state
+// ISR (per instance)
 // ======================
 
-volatile uint32_t SpeedInput::pulseCount = 0;
-
-void IRAM_ATTR SpeedInput::isr()
+void IRAM_ATTR SpeedInput::isr(void *arg)
 {
-	pulseCount++;
+	static_cast<SpeedInput *>(arg)->events.push(micros());
 }
 
 // ======================
@@ -16,43 +14,35 @@ void IRAM_ATTR SpeedInput::isr()
 // ======================
 
 SpeedInput::SpeedInput(uint8_t p, float mpp)
-	: pin(p), metersPerPulse(mpp) {}
+	: pin(p), metersPerPulse(mpp), estimator(mpp) {}
 
 void SpeedInput::begin()
 {
 	pinMode(pin, INPUT);
-	attachInterrupt(digitalPinToInterrupt(pin), isr, CHANGE);
-	lastSampleMs = millis();
+	attachInterruptArg(digitalPinToInterrupt(pin), isr, this, CHANGE);
 }
 
-void SpeedInput::update()
+void SpeedInput::drainEvents()
 {
-	uint32_t now = millis();
-	uint32_t dtMs = now - lastSampleMs;
-
-	if (dtMs < 100)
-		return; // 10 Hz update
-
-	noInterrupts();
-	uint32_t pulses = pulseCount;
-	pulseCount = 0;
-	interrupts();
-
-	float distanceMeters = pulses * metersPerPulse;
-	float speedMps = distanceMeters / (dtMs / 1000.0f);
-	float speedKph = speedMps * 3.6f;
+	uint32_t stamp;
+	while (events.pop(stamp))
+	{
+		estimator.addPulse(stamp);
+		totalPulses++;
+	}
+}
 
-	// smoothing
-	speedFiltered =
-		0.25f * speedKph +
-		0.75f * speedFiltered;
+void SpeedInput::update()
+{
+	drainEvents();
 
-	lastSampleMs = now;
+	// After draining: every stamp handed over is older than nowUs
+	estimator.update(micros());
 }
 
 float SpeedInput::speedKph() const
 {
-	return speedFiltered;
+	return estimator.speedKph();
 }
 
 // ======================
@@ -64,6 +54,7 @@ void SpeedInput::setMetersPerPulse(float mpp)
 	if (mpp > 0.0f)
 	{
 		metersPerPulse = mpp;
+		estimator.setMetersPerPulse(mpp);
 	}
 }
 
@@ -74,15 +65,16 @@ float SpeedInput::getMetersPerPulse() const
 
 void SpeedInput::resetPulseCounter()
 {
-	noInterrupts();
-	pulseCount = 0;
-	interrupts();
+	resetCount = totalPulses;
 }
 
 uint32_t SpeedInput::pulsesSinceReset() const
 {
-	noInterrupts();
-	uint32_t p = pulseCount;
-	interrupts();
-	return p;
+	// Counted as of the last update()
+	return totalPulses - resetCount;
+}
+
+uint32_t SpeedInput::droppedPulses() const
+{
+	return events.dropped();
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 #include <Arduino.h>
+#include <SpscRing.h>
+#include <SpeedEstimator.h>
 
 class SpeedInput
 {
@@ -19,13 +21,25 @@ public:
 	void resetPulseCounter();
 	uint32_t pulsesSinceReset() const;
 
+	// Edges lost to a full event ring (loop stalled)
+	uint32_t droppedPulses() const;
+
 private:
-	static void IRAM_ATTR isr();
-	static volatile uint32_t pulseCount;
+	// Edge timestamps (micros) from the ISR; 64 edges ≈ 0.4 s at 250 km/h
+	static constexpr uint32_t EVENT_RING = 64;
+
+	// Per-instance: one SpeedInput per sensor, as many as needed
+	static void IRAM_ATTR isr(void *arg);
+	SpscRing<uint32_t, EVENT_RING> events;
+
+	void drainEvents();
 
 	uint8_t pin;
 	float metersPerPulse;
 
-	uint32_t lastSampleMs = 0;
-	float speedFiltered = 0.0f;
+	uint32_t totalPulses = 0;	// since begin(), loop side
+	uint32_t resetCount = 0;	// totalPulses at resetPulseCounter()
+
+	// Period at low speed, timed count at high speed, dt-aware EMA
+	SpeedEstimator estimator;
 };
\ No newline at end of file
@@ -0,0 +1,259 @@
+#ifndef NINA_FILTERS_H
+#define NINA_FILTERS_H
+
+#pragma once
+
+#include <stdint.h>
+
+// Fixed-point filter stages, chained at compile time:
+//
+//   FilterChain<MedianFilter<5>, EmaFilter<500>, HysteresisFilter<8>> f;
+//   int32_t y = f.step(x, dtUs);
+//
+// Every stage takes the elapsed time since its previous sample, so time
+// constants are in real time, not in calls. Values are plain int32_t in
+// whatever fixed-point unit the caller picks (counts × 16, km/h × 100, …).
+// The first step() primes every stage with its input.
+
+// ------------------------------------------------------------------
+// Median of the last N samples – drops single-sample glitches
+// ------------------------------------------------------------------
+template <uint8_t N>
+class MedianFilter
+{
+    static_assert(N % 2 == 1 && N <= 9, "odd window, at most 9");
+
+public:
+    int32_t step(int32_t x, uint32_t)
+    {
+        if (!primed)
+            reset(x);
+
+        window[next] = x;
+        next = next + 1 == N ? 0 : next + 1;
+
+        // Insertion sort of a copy; N ≤ 9 keeps this short
+        int32_t sorted[N];
+        for (uint8_t i = 0; i < N; i++)
+        {
+            int32_t v = window[i];
+            int8_t j = i - 1;
+            while (j >= 0 && sorted[j] > v)
+            {
+                sorted[j + 1] = sorted[j];
+                j--;
+            }
+            sorted[j + 1] = v;
+        }
+
+        return sorted[N / 2];
+    }
+
+    void reset(int32_t x)
+    {
+        for (uint8_t i = 0; i < N; i++)
+        {
+            window[i] = x;
+        }
+        next = 0;
+        primed = true;
+    }
+
+private:
+    int32_t window[N];
+    uint8_t next = 0;
+    bool primed = false;
+};
+
+// ------------------------------------------------------------------
+// First-order low-pass, alpha = dt / (tau + dt)
+// State keeps FRAC extra bits; the rounding error of each step is
+// carried into the next, so small alphas don't stall short of the input.
+// Calls closer together than tau / 256 are batched (latest input wins) so
+// the Q16 alpha stays accurate to < 0.5 %.
+// ------------------------------------------------------------------
+template <uint32_t TAU_MS, uint8_t FRAC = 8>
+class EmaFilter
+{
+public:
+    int32_t step(int32_t x, uint32_t dtUs)
+    {
+        if (!primed)
+        {
+            reset(x);
+            return x;
+        }
+
+        uint32_t tau = TAU_MS * 1000UL;
+
+        pendingUs += dtUs;
+        if (pendingUs < (tau >> 8))
+            return (acc + (1 << (FRAC - 1))) >> FRAC;
+
+        dtUs = pendingUs;
+        pendingUs = 0;
+
+        // alpha in Q16; scale both terms down until dt << 16 fits 32 bits
+        while (dtUs > 0xFFFF)
+        {
+            dtUs >>= 1;
+            tau >>= 1;
+        }
+
+        if (dtUs != 0)
+        {
+            uint32_t alpha = (dtUs << 16) / (tau + dtUs);
+
+            int32_t target = x * (1 << FRAC);
+            int64_t delta = static_cast<int64_t>(target - acc) * alpha + carry;
+            int32_t whole = static_cast<int32_t>(delta >> 16);
+            carry = static_cast<int32_t>(delta - (static_cast<int64_t>(whole) << 16));
+            acc += whole;
+        }
+
+        return (acc + (1 << (FRAC - 1))) >> FRAC;
+    }
+
+    void reset(int32_t x)
+    {
+        acc = x * (1 << FRAC);
+        carry = 0;
+        pendingUs = 0;
+        primed = true;
+    }
+
+private:
+    static_assert(FRAC >= 1 && FRAC <= 12, "FRAC out of range");
+
+    int32_t acc = 0;   // value << FRAC
+    int32_t carry = 0; // Q16 remainder of acc
+    uint32_t pendingUs = 0;
+    bool primed = false;
+};
+
+// ------------------------------------------------------------------
+// Rate limit: output moves toward the input by at most
+// RATE_PER_S units per second
+// ------------------------------------------------------------------
+template <uint32_t RATE_PER_S>
+class SlewLimitFilter
+{
+    // credit = RATE × dt (dt capped at 100 ms) must fit 32 bits
+    static_assert(RATE_PER_S > 0 && RATE_PER_S <= 40000, "RATE_PER_S out of range");
+
+public:
+    int32_t step(int32_t x, uint32_t dtUs)
+    {
+        if (!primed)
+        {
+            reset(x);
+            return x;
+        }
+
+        if (dtUs > MAX_DT_US)
+            dtUs = MAX_DT_US;
+
+        credit += RATE_PER_S * dtUs; // units × µs
+        if (credit > MAX_CREDIT)
+            credit = MAX_CREDIT;
+
+        int32_t allowed = static_cast<int32_t>(credit / 1000000UL);
+        int32_t diff = x - y;
+
+        if (diff > allowed || diff < -allowed)
+        {
+            diff = diff > 0 ? allowed : -allowed;
+            credit -= static_cast<uint32_t>(allowed) * 1000000UL;
+        }
+        else
+        {
+            credit = 0; // caught up – no banked slew for the next jump
+        }
+
+        y += diff;
+        return y;
+    }
+
+    void reset(int32_t x)
+    {
+        y = x;
+        credit = 0;
+        primed = true;
+    }
+
+private:
+    static constexpr uint32_t MAX_DT_US = 100000;
+    static constexpr uint32_t MAX_CREDIT = RATE_PER_S * MAX_DT_US;
+
+    int32_t y = 0;
+    uint32_t credit = 0;
+    bool primed = false;
+};
+
+// ------------------------------------------------------------------
+// Hysteresis: output follows only once the input has moved BAND units
+// away – stops a display flickering between two neighbouring values
+// ------------------------------------------------------------------
+template <uint32_t BAND>
+class HysteresisFilter
+{
+public:
+    int32_t step(int32_t x, uint32_t)
+    {
+        if (!primed)
+            reset(x);
+
+        int32_t d = x - y;
+        if (d >= static_cast<int32_t>(BAND) || d <= -static_cast<int32_t>(BAND))
+            y = x;
+
+        return y;
+    }
+
+    void reset(int32_t x)
+    {
+        y = x;
+        primed = true;
+    }
+
+private:
+    int32_t y = 0;
+    bool primed = false;
+};
+
+// ------------------------------------------------------------------
+// Chain: stages run left to right
+// ------------------------------------------------------------------
+template <typename... Stages>
+class FilterChain;
+
+template <>
+class FilterChain<>
+{
+public:
+    int32_t step(int32_t x, uint32_t) { return x; }
+    void reset(int32_t) {}
+};
+
+template <typename First, typename... Rest>
+class FilterChain<First, Rest...>
+{
+public:
+    int32_t step(int32_t x, uint32_t dtUs)
+    {
+        return rest.step(first.step(x, dtUs), dtUs);
+    }
+
+    // Start every stage at x (no settling from zero)
+    void reset(int32_t x)
+    {
+        first.reset(x);
+        rest.reset(x);
+    }
+
+private:
+    First first;
+    FilterChain<Rest...> rest;
+};
+
+#endif // NINA_FILTERS_H
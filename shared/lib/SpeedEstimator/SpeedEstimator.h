@@ -0,0 +1,177 @@
+#ifndef NINA_SPEEDESTIMATOR_H
+#define NINA_SPEEDESTIMATOR_H
+
+#pragma once
+
+#include <stdint.h>
+
+// Reciprocal-frequency (M/T) speed estimate from timestamped hall edges.
+//
+// Every measurement spans whole magnet cycles and is timed from edge to
+// edge, never from loop time:
+//   speed = N × metersPerPulse / (t_last_edge − t_ref_edge)
+// At low speed a measurement closes as soon as one cycle completes (pure
+// period); at high speed edges accumulate over windowUs (count over an
+// exactly timed window). The two regimes blend on their own – no switch.
+//
+// Between edges the still-open interval bounds the speed from above, so
+// the reading decays while slowing down; after standstillUs without an
+// edge it snaps to 0. A dt-aware EMA (alpha = dt / (tau + dt)) smooths
+// the result independently of the loop rate.
+//
+// Plain C++ – no Arduino dependency, builds on both boards and the host.
+class SpeedEstimator
+{
+public:
+    static constexpr uint8_t MAX_EDGES_PER_CYCLE = 4;
+
+    explicit SpeedEstimator(
+        float metersPerPulse,
+        uint8_t edgesPerCycle = 2,      // CHANGE on a 2-pole magnet
+        uint32_t windowUs = 40000,      // minimum count window
+        uint32_t standstillUs = 1500000,
+        float tauS = 0.03f)
+        : metersPerPulse(metersPerPulse),
+          edgesPerCycle(edgesPerCycle == 0 ? 1 : (edgesPerCycle > MAX_EDGES_PER_CYCLE ? MAX_EDGES_PER_CYCLE : edgesPerCycle)),
+          windowUs(windowUs),
+          standstillUs(standstillUs),
+          tauS(tauS)
+    {
+    }
+
+    void setMetersPerPulse(float mpp)
+    {
+        metersPerPulse = mpp;
+    }
+
+    // One edge, stamped by the ISR (micros)
+    void addPulse(uint32_t us)
+    {
+        pushRecent(us);
+
+        if (!haveRef)
+        {
+            refUs = us;
+            haveRef = true;
+            pending = 0;
+            return;
+        }
+
+        pending++;
+    }
+
+    // Edges without timestamps (hardware counter): all stamped at nowUs
+    void addPulses(uint32_t count, uint32_t nowUs)
+    {
+        for (uint32_t i = 0; i < count && i < MAX_EDGES_PER_CYCLE; i++)
+        {
+            pushRecent(nowUs);
+        }
+
+        if (count == 0)
+            return;
+
+        if (!haveRef)
+        {
+            refUs = nowUs;
+            haveRef = true;
+            pending = 0;
+            return;
+        }
+
+        pending += count;
+    }
+
+    void update(uint32_t nowUs)
+    {
+        float dtS = started ? (nowUs - lastUpdateUs) * 1e-6f : 0.0f;
+        lastUpdateUs = nowUs;
+        started = true;
+
+        if (!haveRef)
+        {
+            rawKph = 0.0f;
+            filteredKph = 0.0f;
+            return;
+        }
+
+        // Close a measurement on whole cycles once the window has passed
+        if (pending >= edgesPerCycle && nowUs - refUs >= windowUs)
+        {
+            uint32_t extra = pending % edgesPerCycle; // newer, partial cycle
+            uint32_t n = pending - extra;
+            uint32_t endUs = recent[(recentHead + MAX_EDGES_PER_CYCLE - 1 - extra) % MAX_EDGES_PER_CYCLE];
+            uint32_t spanUs = endUs - refUs;
+
+            if (spanUs > 0)
+            {
+                rawKph = n * metersPerPulse * 3.6e6f / spanUs;
+                refUs = endUs;
+                pending = extra;
+            }
+        }
+        else
+        {
+            uint32_t openUs = nowUs - refUs;
+
+            if (openUs >= standstillUs)
+            {
+                // Standstill: next edge starts a fresh reference
+                haveRef = false;
+                pending = 0;
+                rawKph = 0.0f;
+                filteredKph = 0.0f;
+                return;
+            }
+
+            // The next measurement closes on the next whole cycle, no
+            // earlier than now – it can't be faster than this
+            uint32_t n = pending - pending % edgesPerCycle + edgesPerCycle;
+            float boundKph = n * metersPerPulse * 3.6e6f / openUs;
+            if (boundKph < rawKph)
+                rawKph = boundKph;
+        }
+
+        float alpha = tauS + dtS > 0.0f ? dtS / (tauS + dtS) : 1.0f; // tau 0 = raw
+        filteredKph += alpha * (rawKph - filteredKph);
+    }
+
+    float speedKph() const
+    {
+        return filteredKph;
+    }
+
+    // Unfiltered last measurement / bound
+    float rawSpeedKph() const
+    {
+        return rawKph;
+    }
+
+private:
+    void pushRecent(uint32_t us)
+    {
+        recent[recentHead] = us;
+        recentHead = (recentHead + 1) % MAX_EDGES_PER_CYCLE;
+    }
+
+    float metersPerPulse;
+    uint8_t edgesPerCycle;
+    uint32_t windowUs;
+    uint32_t standstillUs;
+    float tauS;
+
+    // Newest edge at recentHead - 1
+    uint32_t recent[MAX_EDGES_PER_CYCLE]{};
+    uint8_t recentHead = 0;
+
+    bool haveRef = false;
+    uint32_t refUs = 0;   // edge that closed the last measurement
+    uint32_t pending = 0; // edges since refUs
+
+    bool started = false;
+    uint32_t lastUpdateUs = 0;
+    float rawKph = 0.0f;
+    float filteredKph = 0.0f;
+};
+
+#endif // NINA_SPEEDESTIMATOR_H
@@ -0,0 +1,88 @@
+#ifndef NINA_SPSCRING_H
+#define NINA_SPSCRING_H
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+
+// Lock-free single-producer / single-consumer ring.
+//
+// Producer: one ISR (or task). Consumer: loop(). Neither side ever blocks
+// or masks interrupts; push() is wait-free and always inlined, so it runs
+// from the caller's IRAM and never touches flash.
+//
+// Indices are free-running 32-bit counters (N must be a power of two);
+// each is written by one side only, so only plain atomic loads and stores
+// are used – single instructions on Xtensa and on the C3's RV32IMC,
+// which has no atomic read-modify-write. A full ring drops the new event and
+// counts it – the producer never overwrites what the consumer may be
+// reading.
+template <typename T, uint32_t N>
+class SpscRing
+{
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of two");
+
+public:
+    static constexpr uint32_t CAPACITY = N;
+
+    // --- producer side
+    __attribute__((always_inline)) inline bool push(const T &item)
+    {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= N)
+        {
+            drops.store(drops.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        slots[h & (N - 1)] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // --- consumer side
+    bool pop(T &item)
+    {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire))
+            return false;
+
+        item = slots[t & (N - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    uint32_t size() const
+    {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed);
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    // Events lost to a full ring since boot (free-running, take deltas)
+    uint32_t dropped() const
+    {
+        return drops.load(std::memory_order_relaxed);
+    }
+
+    // Events accepted since boot (free-running)
+    uint32_t pushed() const
+    {
+        return head.load(std::memory_order_acquire);
+    }
+
+private:
+    T slots[N]{};
+
+    // Separate words – the producer only writes head/drops, the consumer
+    // only writes tail
+    std::atomic<uint32_t> head{0};
+    std::atomic<uint32_t> tail{0};
+    std::atomic<uint32_t> drops{0};
+};
+
+#endif // NINA_SPSCRING_H